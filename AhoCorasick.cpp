@@ -0,0 +1,84 @@
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "AhoCorasick.hpp"
+
+const std::uint32_t AhoCorasick::OUTPUT = 0x80000000u;
+const std::uint32_t AhoCorasick::NONE = 0xFFFFFFFFu;
+
+/**
+* @brief Builds automaton from keys of Trie.
+* @param[in] i_trie Trie.
+* @throw std::length_error If table or alphabet is too large.
+*/
+AhoCorasick::AhoCorasick(const Trie & i_trie)
+    : m_stride(static_cast<std::uint32_t>(i_trie.alphabet_size() + 1))
+{
+    const std::size_t alphabet = i_trie.alphabet_size();
+    if (alphabet > 255)
+    {
+        throw std::length_error("AhoCorasick: alphabet exceeds 255 characters");
+    }
+
+    // column 0 is for characters outside of alphabet
+    for (std::size_t chr = 0; chr < 256; ++chr)
+    {
+        const std::size_t idx = static_cast<unsigned char>(chr - 'a');
+        m_class[chr] = (idx < alphabet) ? static_cast<std::uint8_t>(idx + 1) : 0;
+    }
+
+    // states in BFS order, so failure of state is built before the state
+    std::vector<const Trie::TrieNode *> nodes(1, i_trie.root());
+    std::vector<std::uint32_t> fail(1, 0);
+    m_depth.assign(1, 0);
+    m_value.assign(1, 0);
+    m_output.assign(1, NONE);
+
+    for (std::size_t state = 0; state < nodes.size(); ++state)
+    {
+        // row offsets of all known states must stay below flag of output
+        if (nodes.size() * m_stride > OUTPUT)
+        {
+            throw std::length_error("AhoCorasick: transition table exceeds 2^31 entries");
+        }
+
+        m_table.resize(m_table.size() + m_stride, 0);
+        std::uint32_t * row = &m_table[state * m_stride];
+        const std::uint32_t * fail_row = &m_table[fail[state] * m_stride];
+
+        for (std::size_t pos = 0; pos < alphabet; ++pos)
+        {
+            const Trie::TrieNode * child = nodes[state]->child[pos];
+            if (child == nullptr)
+            {
+                // missing edge continues from failure
+                row[pos + 1] = (state == 0) ? 0 : fail_row[pos + 1];
+                continue;
+            }
+
+            const std::uint32_t next = static_cast<std::uint32_t>(nodes.size());
+            const std::uint32_t next_fail = (state == 0) ? 0 : fail_row[pos + 1] / m_stride;
+
+            nodes.push_back(child);
+            fail.push_back(next_fail);
+            m_depth.push_back(m_depth[state] + 1);
+            m_value.push_back(child->value);
+            m_output.push_back((m_value[next_fail] > 0) ? next_fail : m_output[next_fail]);
+
+            row[pos + 1] = next * m_stride;
+        }
+    }
+
+    // mark transitions to states with output
+    for (std::size_t pos = 0; pos < m_table.size(); ++pos)
+    {
+        const std::uint32_t state = m_table[pos] / m_stride;
+        if (m_value[state] > 0 || m_output[state] != NONE)
+        {
+            m_table[pos] |= OUTPUT;
+        }
+    }
+}
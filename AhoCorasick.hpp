@@ -0,0 +1,129 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "Trie.hpp"
+
+/**
+ * @brief Aho-Corasick automaton which finds all keys of Trie in text.
+ *
+ * Transitions are compiled into dense table with one row per state and one
+ * column per character of Trie alphabet plus column for other characters, so
+ * each byte of text costs one table lookup. Entries are offsets of rows with
+ * flag of states which have output, so states without matches are passed
+ * without touching other arrays. Table is limited to 2^31 entries and
+ * alphabet to 255 characters, constructor throws std::length_error otherwise.
+ */
+class AhoCorasick
+{
+public:
+    /**
+     * @brief Position of scan in stream, allows scanning text split into chunks.
+     */
+    struct Cursor
+    {
+        std::uint32_t state;     /**< Offset of row of current state.   */
+        std::size_t offset;      /**< Number of scanned characters.     */
+
+        /**
+         * @brief Constructs cursor at the beginning of stream.
+         */
+        Cursor()
+            : state(0)
+            , offset(0)
+        {}
+    };
+
+    /**
+     * @brief Builds automaton from keys of Trie.
+     * @param[in] i_trie Trie.
+     * @throw std::length_error If table or alphabet is too large.
+     */
+    AhoCorasick(const Trie & i_trie);
+
+    /**
+     * @brief Gets number of states.
+     */
+    std::size_t num_states() const
+    {
+        return m_depth.size();
+    }
+
+    /**
+     * @brief Scans chunk of stream and reports all keys which end in it.
+     *
+     * Matches which start in previous chunks are reported as well.
+     *
+     * @param[in,out] io_cursor Position in stream.
+     * @param[in] i_chunk Next chunk of stream.
+     * @param[in] i_func Callback func(end, length, value), end is offset in stream after match.
+     */
+    template<class Func>
+    void scan(Cursor & io_cursor, std::string_view i_chunk, Func i_func) const
+    {
+        const std::uint32_t * table = m_table.data();
+        const std::uint8_t * classes = m_class;
+        std::uint32_t state = io_cursor.state;
+
+        for (std::size_t pos = 0; pos < i_chunk.size(); ++pos)
+        {
+            state = table[state + classes[static_cast<unsigned char>(i_chunk[pos])]];
+            if (state & OUTPUT)
+            {
+                state &= ~OUTPUT;
+                report(state / m_stride, io_cursor.offset + pos + 1, i_func);
+            }
+        }
+
+        io_cursor.state = state;
+        io_cursor.offset += i_chunk.size();
+    }
+
+    /**
+     * @brief Scans chunk of stream using internal cursor.
+     * @param[in] i_chunk Next chunk of stream.
+     * @param[in] i_func Callback func(end, length, value), end is offset in stream after match.
+     */
+    template<class Func>
+    void scan(std::string_view i_chunk, Func i_func)
+    {
+        scan(m_cursor, i_chunk, i_func);
+    }
+
+    /**
+     * @brief Moves internal cursor to the beginning of stream.
+     */
+    void reset()
+    {
+        m_cursor = Cursor();
+    }
+
+private:
+    /**
+     * @brief Reports all keys which end in state.
+     */
+    template<class Func>
+    void report(std::uint32_t i_state, std::size_t i_end, Func & i_func) const
+    {
+        std::uint32_t state = (m_value[i_state] > 0) ? i_state : m_output[i_state];
+        while (state != NONE)
+        {
+            i_func(i_end, static_cast<std::size_t>(m_depth[state]), m_value[state]);
+            state = m_output[state];
+        }
+    }
+
+    static const std::uint32_t OUTPUT;    /**< Flag of states with output.      */
+    static const std::uint32_t NONE;      /**< Missing state.                   */
+
+    std::vector<std::uint32_t> m_table;   /**< Transitions, offsets of rows.    */
+    std::vector<std::uint32_t> m_depth;   /**< Depth of states.                 */
+    std::vector<int> m_value;             /**< Values of keys of states.        */
+    std::vector<std::uint32_t> m_output;  /**< Nearest key state by failures.   */
+    std::uint8_t m_class[256];            /**< Columns of characters.           */
+    std::uint32_t m_stride;               /**< Length of row.                   */
+    Cursor m_cursor;                      /**< Internal cursor.                 */
+};
@@ -1,23 +1,16 @@
 #include <vector>
+#include <utility>
+#include <algorithm>
+#include <thread>
 
 #include "BIT.hpp"
 
 namespace
 {
     /**
-     * @brief Utility function, updates value in array.
+     * @brief Minimal number of queries or updates processed by one thread.
      */
-    void update_util(std::vector<int> & io_tree, int i_n, int i_idx, int i_val)
-    {
-        i_idx++;
-        while (i_idx <= i_n)
-        {
-            // add value to node
-            io_tree[i_idx] += i_val;
-            // move to child node
-            i_idx += i_idx & (-i_idx);
-        }
-    }
+    const std::size_t PARALLEL_GRAIN = 1 << 16;
 }
 
 /**
@@ -25,20 +18,9 @@ namespace
 * @param[in] i_arr Array of values.
 */
 BinaryIndexedTree::BinaryIndexedTree(const std::vector<int> & i_arr)
-{
-    const int n = i_arr.size();
-    // allocate memory for tree
-    m_tree = std::vector<int>(n + 1);
-
-    // add all values from array
-    for (int pos = 0; pos < n; pos++)
-    {
-        update_util(m_tree, n, pos, i_arr[pos]);
-    }
-
-    // save original array
-    m_orig = i_arr;
-}
+    : m_tree(i_arr)
+    , m_orig(i_arr)
+{}
 
 /**
 * @brief Gets sum of values from array in range 0..idx
@@ -47,18 +29,7 @@ BinaryIndexedTree::BinaryIndexedTree(const std::vector<int> & i_arr)
 */
 int BinaryIndexedTree::get_sum(int i_idx) const
 {
-    int s = 0;
-    i_idx++;
-    // traverse from child
-    while (i_idx > 0)
-    {
-        // add to sum
-        s += m_tree[i_idx];
-        // move to parent
-        i_idx -= i_idx & (-i_idx);
-    }
-
-    return s;
+    return m_tree.prefix_sum(i_idx);
 }
 
 /**
@@ -68,7 +39,6 @@ int BinaryIndexedTree::get_sum(int i_idx) const
 */
 void BinaryIndexedTree::update(int i_idx, int i_val)
 {
-    const int n = m_orig.size();
     // get old value
     int old = m_orig[i_idx];
 
@@ -78,5 +48,183 @@ void BinaryIndexedTree::update(int i_idx, int i_val)
     m_orig[i_idx] = i_val;
 
     // update all nodes
-    update_util(m_tree, n, i_idx, diff);
+    m_tree.add(i_idx, diff);
+}
+
+/**
+* @brief Finds smallest index whose prefix sum is not less than given value.
+* @note All values in array should be non-negative.
+* @param[in] i_sum Required prefix sum.
+* @return Index in array or array size if there is no such index.
+*/
+int BinaryIndexedTree::lower_bound(int i_sum) const
+{
+    return static_cast<int>(m_tree.lower_bound(i_sum));
+}
+
+/**
+* @brief Updates values of array at given indices.
+* @note If index occurs several times the last value is used.
+* @param[in] i_updates Pairs (Index, New value).
+*/
+void BinaryIndexedTree::update_many(const std::vector<std::pair<int, int>> & i_updates)
+{
+    const int n = m_orig.size();
+
+    // sort by index, keep input order for equal indices
+    std::vector<std::pair<int, int>> updates = i_updates;
+    std::stable_sort(updates.begin(), updates.end(),
+        [](const std::pair<int, int> & i_left, const std::pair<int, int> & i_right) { return i_left.first < i_right.first; });
+
+    // number of bits in n
+    int log_n = 1;
+    while ((1 << log_n) < n)
+    {
+        log_n++;
+    }
+
+    // large batch, rebuilding tree is cheaper than separate updates
+    const bool rebuild = updates.size() * log_n > static_cast<std::size_t>(n);
+
+    // pairs (Index, Difference) of changed values
+    std::size_t count = 0;
+    for (std::size_t pos = 0; pos < updates.size(); ++pos)
+    {
+        // skip all but last update of index
+        if (pos + 1 < updates.size() && updates[pos + 1].first == updates[pos].first)
+        {
+            continue;
+        }
+
+        const int idx = updates[pos].first;
+        const int diff = updates[pos].second - m_orig[idx];
+        m_orig[idx] = updates[pos].second;
+
+        if (diff != 0)
+        {
+            updates[count++] = std::make_pair(idx, diff);
+        }
+    }
+
+    if (rebuild)
+    {
+        m_tree = FenwickTree<int>(m_orig);
+        return;
+    }
+
+    // split work between threads
+    std::size_t num_threads = std::thread::hardware_concurrency();
+    num_threads = std::min(num_threads, count / PARALLEL_GRAIN);
+
+    if (num_threads <= 1)
+    {
+        for (std::size_t pos = 0; pos < count; ++pos)
+        {
+            m_tree.add(updates[pos].first, updates[pos].second);
+        }
+    }
+    else
+    {
+        // aligned ranges of nodes, update path leaves range only through its last node
+        std::size_t range = 1;
+        while (range * num_threads < static_cast<std::size_t>(n))
+        {
+            range *= 2;
+        }
+
+        std::vector<int> carry((n + range - 1) / range, 0);
+        std::vector<std::thread> workers;
+        std::size_t begin = 0;
+        for (std::size_t part = 0; part < carry.size(); ++part)
+        {
+            // updates of nodes part * range + 1..last, node of index is index + 1
+            const std::size_t last = std::min((part + 1) * range, static_cast<std::size_t>(n));
+            std::size_t end = begin;
+            while (end < count && static_cast<std::size_t>(updates[end].first) < last)
+            {
+                end++;
+            }
+
+            workers.push_back(std::thread([this, &updates, &carry, part, begin, end, last]()
+            {
+                for (std::size_t pos = begin; pos < end; ++pos)
+                {
+                    m_tree.add_path(updates[pos].first + 1, updates[pos].second, last);
+                    carry[part] += updates[pos].second;
+                }
+            }));
+            begin = end;
+        }
+
+        for (std::size_t pos = 0; pos < workers.size(); ++pos)
+        {
+            workers[pos].join();
+        }
+
+        // rest of paths is shared by all nodes of range
+        for (std::size_t part = 0; part < carry.size(); ++part)
+        {
+            if (carry[part] != 0)
+            {
+                m_tree.add_path(FenwickTree<int>::update_next((part + 1) * range), carry[part], n);
+            }
+        }
+    }
+}
+
+/**
+* @brief Gets prefix sums for given indices.
+* @param[in] i_idxs Right most indices.
+* @return Sums of ranges in the same order as indices.
+*/
+std::vector<int> BinaryIndexedTree::get_sum_many(const std::vector<int> & i_idxs) const
+{
+    // sorted distinct indices
+    std::vector<int> keys = i_idxs;
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+    std::vector<int> sums(keys.size());
+
+    // split work between threads
+    std::size_t num_threads = std::thread::hardware_concurrency();
+    num_threads = std::min(num_threads, keys.size() / PARALLEL_GRAIN);
+
+    if (num_threads <= 1)
+    {
+        for (std::size_t pos = 0; pos < keys.size(); ++pos)
+        {
+            sums[pos] = m_tree.prefix_sum(keys[pos]);
+        }
+    }
+    else
+    {
+        std::vector<std::thread> workers;
+        const std::size_t chunk = (keys.size() + num_threads - 1) / num_threads;
+        for (std::size_t begin = 0; begin < keys.size(); begin += chunk)
+        {
+            const std::size_t end = std::min(begin + chunk, keys.size());
+            workers.push_back(std::thread([this, &keys, &sums, begin, end]()
+            {
+                for (std::size_t pos = begin; pos < end; ++pos)
+                {
+                    sums[pos] = m_tree.prefix_sum(keys[pos]);
+                }
+            }));
+        }
+
+        for (std::size_t pos = 0; pos < workers.size(); ++pos)
+        {
+            workers[pos].join();
+        }
+    }
+
+    // scatter results to original order
+    std::vector<int> res(i_idxs.size());
+    for (std::size_t pos = 0; pos < i_idxs.size(); ++pos)
+    {
+        res[pos] = sums[std::lower_bound(keys.begin(), keys.end(), i_idxs[pos]) - keys.begin()];
+    }
+
+    return res;
 }
@@ -1,7 +1,11 @@
 #pragma once
 
+#include <cstddef>
+#include <utility>
 #include <vector>
 
+#include "FenwickTree.hpp"
+
 /**
  * @brief Binary Indexed Tree definition.
  */
@@ -28,7 +32,29 @@ public:
      */
     void update(int i_idx, int i_val);
 
+    /**
+     * @brief Finds smallest index whose prefix sum is not less than given value.
+     * @note All values in array should be non-negative.
+     * @param[in] i_sum Required prefix sum.
+     * @return Index in array or array size if there is no such index.
+     */
+    int lower_bound(int i_sum) const;
+
+    /**
+     * @brief Updates values of array at given indices.
+     * @note If index occurs several times the last value is used.
+     * @param[in] i_updates Pairs (Index, New value).
+     */
+    void update_many(const std::vector<std::pair<int, int>> & i_updates);
+
+    /**
+     * @brief Gets prefix sums for given indices.
+     * @param[in] i_idxs Right most indices.
+     * @return Sums of ranges in the same order as indices.
+     */
+    std::vector<int> get_sum_many(const std::vector<int> & i_idxs) const;
+
 private:
-    std::vector<int> m_tree;    /**< Data stored in tree. */
+    FenwickTree<int> m_tree;    /**< Data stored in tree. */
     std::vector<int> m_orig;    /**< Original array.      */
 };
\ No newline at end of file
@@ -1,10 +1,15 @@
 #pragma once
 
 #include <cstddef>
-#include <algorithm>
+#include <utility>
+#include <vector>
 
 /**
  * @brief Minimum Binary Heap implementation.
+ *
+ * Keys are compared by operator< only and moved instead of copied, so heap
+ * can store move-only keys.
+ *
  * @tparam KeyType Type of keys stored in binary heap.
  */
 template<class KeyType>
@@ -13,15 +18,11 @@ class MinHeap
 public:
     /**
      * @brief Minimum heap constructor.
-     * @param[in] i_capacity Capacity of heap.
+     * @param[in] i_capacity Number of keys to reserve memory for, heap grows beyond it.
      */
-    MinHeap(const std::size_t i_capacity)
+    MinHeap(const std::size_t i_capacity = 0U)
     {
-        // allocate memory for heap
-        m_heap = new KeyType[i_capacity];
-        m_capacity = i_capacity;
-        // currently heap is empty
-        m_size = 0U;
+        m_heap.reserve(i_capacity);
     }
 
     /**
@@ -58,37 +59,42 @@ public:
         return 2 * i_parent + 2;
     }
 
+    /**
+     * @brief Gets number of keys in heap.
+     */
+    std::size_t size() const
+    {
+        return m_heap.size();
+    }
+
+    /**
+     * @brief Checks whether heap is empty.
+     */
+    bool empty() const
+    {
+        return m_heap.empty();
+    }
+
+    /**
+     * @brief Reserves memory for given number of keys.
+     * @param[in] i_capacity Number of keys.
+     */
+    void reserve(const std::size_t i_capacity)
+    {
+        m_heap.reserve(i_capacity);
+    }
+
     /**
     * @brief Heapify subtree with given index.
     * @param[in] i_idx Input index.
     */
     void heapify(std::size_t i_idx)
     {
-        // left child
-        const std::size_t l_idx = left(i_idx);
-        // right child
-        const std::size_t r_idx = right(i_idx);
-
-        // contains index of smallest key
-        std::size_t smallest = i_idx;
-
-        if (l_idx < m_size && m_heap[l_idx] < m_heap[smallest])
+        if (i_idx >= m_heap.size())
         {
-            smallest = l_idx;
-        }
-        if (r_idx < m_size && m_heap[r_idx] < m_heap[smallest])
-        {
-            smallest = r_idx;
-        }
-
-        // if smallest in root then nothing to do
-        if (smallest != i_idx)
-        {
-            // swap root with child
-            std::swap(m_heap[i_idx], m_heap[smallest]);
-            // recursively call for child
-            heapify(smallest);
+            return;
         }
+        sift_down(i_idx);
     }
 
     /**
@@ -97,21 +103,29 @@ public:
      */
     void insert_key(const KeyType & i_key)
     {
-        // check if there are free space
-        if (m_size < m_capacity)
-        {
-            // store key and increase sheap size
-            m_heap[m_size++] = i_key;
+        m_heap.push_back(i_key);
+        sift_up(m_heap.size() - 1);
+    }
 
-            std::size_t idx = m_size - 1;
-            // fix heap property
-            while (idx > 0U && m_heap[parent(idx)] > m_heap[idx])
-            {
-                // swap parent and child
-                std::swap(m_heap[idx], m_heap[parent(idx)]);
-                idx = parent(idx);
-            }
-        }
+    /**
+     * @brief Adds new key to heap.
+     * @param[in] i_key Key to be moved into heap.
+     */
+    void insert_key(KeyType && i_key)
+    {
+        m_heap.push_back(std::move(i_key));
+        sift_up(m_heap.size() - 1);
+    }
+
+    /**
+     * @brief Constructs new key in place.
+     * @param[in] i_args Arguments of key constructor.
+     */
+    template<class... Args>
+    void emplace(Args &&... i_args)
+    {
+        m_heap.emplace_back(std::forward<Args>(i_args)...);
+        sift_up(m_heap.size() - 1);
     }
 
     /**
@@ -120,14 +134,36 @@ public:
      */
     void delete_key(const std::size_t i_idx)
     {
+        if (i_idx >= m_heap.size())
+        {
+            return;
+        }
 
+        // last key fills the hole, it may go either up or down
+        if (i_idx + 1 < m_heap.size())
+        {
+            m_heap[i_idx] = std::move(m_heap.back());
+        }
+        m_heap.pop_back();
+
+        if (i_idx < m_heap.size())
+        {
+            if (i_idx > 0U && m_heap[i_idx] < m_heap[parent(i_idx)])
+            {
+                sift_up(i_idx);
+            }
+            else
+            {
+                sift_down(i_idx);
+            }
+        }
     }
 
     /**
      * @brief Gets minimum element in heap.
      * @return Value stored in root.
      */
-    KeyType get_min() const
+    const KeyType & get_min() const
     {
         return m_heap[0];
     }
@@ -138,22 +174,21 @@ public:
      */
     KeyType extract_min()
     {
-        // heap contains only one element
-        if (m_size == 1U)
+        // store resulting value
+        KeyType res = std::move(m_heap[0]);
+
+        // move last element to root
+        if (m_heap.size() > 1U)
         {
-            m_size = 0U;
-            return m_heap[0];
+            m_heap[0] = std::move(m_heap.back());
         }
-
-        // store resulting value
-        KeyType res = m_heap[0];
-        // copy last element
-        m_heap[0] = m_heap[m_size - 1];
-        // decrease size of heap
-        m_size--;
+        m_heap.pop_back();
 
         // move key from root to correct place
-        heapify(0U);
+        if (!m_heap.empty())
+        {
+            sift_down(0U);
+        }
 
         return res;
     }
@@ -163,29 +198,63 @@ public:
      * @param[in] i_idx Index of node.
      * @param[in] i_key New key (should be less than current key).
      */
-    void decrease_key(std::size_t i_idx, const KeyType & i_key)
+    void decrease_key(std::size_t i_idx, KeyType i_key)
     {
         // store new key
-        m_heap[i_idx] = i_key;
+        m_heap[i_idx] = std::move(i_key);
 
-        // swap child key with parent key until parent key is greater (keep heap property)
-        while (i_idx > 0U && m_heap[parent(i_idx)] > m_heap[i_idx])
+        // move key up until parent key is not greater (keep heap property)
+        sift_up(i_idx);
+    }
+
+private:
+    /**
+     * @brief Moves key up to its place, parents are shifted down into hole.
+     * @param[in] i_idx Index of key.
+     */
+    void sift_up(std::size_t i_idx)
+    {
+        KeyType key = std::move(m_heap[i_idx]);
+        while (i_idx > 0U && key < m_heap[parent(i_idx)])
         {
-            std::swap(m_heap[i_idx], m_heap[parent(i_idx)]);
+            m_heap[i_idx] = std::move(m_heap[parent(i_idx)]);
             i_idx = parent(i_idx);
         }
+        m_heap[i_idx] = std::move(key);
     }
 
     /**
-     * @brief Destructor.
+     * @brief Moves key down to its place, smaller children are shifted up into hole.
+     * @param[in] i_idx Index of key.
      */
-    ~MinHeap()
+    void sift_down(std::size_t i_idx)
     {
-        delete [] m_heap;
+        const std::size_t size = m_heap.size();
+        KeyType key = std::move(m_heap[i_idx]);
+        for (;;)
+        {
+            // contains index of smallest child
+            std::size_t smallest = left(i_idx);
+            if (smallest >= size)
+            {
+                break;
+            }
+            if (smallest + 1 < size && m_heap[smallest + 1] < m_heap[smallest])
+            {
+                smallest++;
+            }
+
+            // if key is not greater than children then nothing to do
+            if (!(m_heap[smallest] < key))
+            {
+                break;
+            }
+
+            m_heap[i_idx] = std::move(m_heap[smallest]);
+            i_idx = smallest;
+        }
+        m_heap[i_idx] = std::move(key);
     }
 
-private:
-    KeyType*     m_heap;        /**< Binary heap data.   */
-    std::size_t  m_capacity;    /**< Capacity of heap.   */
-    std::size_t  m_size;        /**< Size of heap.       */
+    std::vector<KeyType> m_heap;    /**< Binary heap data.   */
 };
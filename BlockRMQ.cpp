@@ -0,0 +1,177 @@
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "BlockRMQ.hpp"
+
+namespace
+{
+    /**
+     * @brief Number of elements in block.
+     */
+    const int BLOCK = 32;
+
+    /**
+     * @brief Index of highest set bit.
+     */
+    int highest_bit(std::uint32_t i_mask)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return 31 - __builtin_clz(i_mask);
+#else
+        int res = 0;
+        while (i_mask >>= 1)
+        {
+            res++;
+        }
+        return res;
+#endif
+    }
+
+    /**
+     * @brief Index of lowest set bit.
+     */
+    int lowest_bit(std::uint32_t i_mask)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_ctz(i_mask);
+#else
+        int res = 0;
+        while ((i_mask & 1) == 0)
+        {
+            i_mask >>= 1;
+            res++;
+        }
+        return res;
+#endif
+    }
+
+    /**
+     * @brief Finds index of minimum of each block.
+     * @param[in] i_arr Input array.
+     * @return Index of left most minimum of each block.
+     */
+    std::vector<int> block_minima(const std::vector<int> & i_arr)
+    {
+        const int n = i_arr.size();
+        std::vector<int> res;
+        for (int start = 0; start < n; start += BLOCK)
+        {
+            int best = start;
+            for (int pos = start + 1; pos < n && pos < start + BLOCK; ++pos)
+            {
+                if (i_arr[pos] < i_arr[best])
+                {
+                    best = pos;
+                }
+            }
+            res.push_back(best);
+        }
+        return res;
+    }
+
+    /**
+     * @brief Collects values of block minima.
+     */
+    std::vector<int> block_values(const std::vector<int> & i_arr, const std::vector<int> & i_idxs)
+    {
+        std::vector<int> res(i_idxs.size());
+        for (std::size_t pos = 0; pos < i_idxs.size(); ++pos)
+        {
+            res[pos] = i_arr[i_idxs[pos]];
+        }
+        return res;
+    }
+}
+
+/**
+* @brief Constructs structure from given array.
+* @param[in] i_arr Input array.
+*/
+BlockRMQ::BlockRMQ(const std::vector<int> & i_arr)
+    : m_arr(i_arr)
+    , m_masks(i_arr.size())
+    , m_block_min(block_minima(i_arr))
+    , m_blocks(block_values(i_arr, m_block_min))
+{
+    const int n = m_arr.size();
+
+    for (int start = 0; start < n; start += BLOCK)
+    {
+        // positions of monotonic stack inside block
+        std::uint32_t stack = 0;
+        for (int pos = start; pos < n && pos < start + BLOCK; ++pos)
+        {
+            // pop greater elements, equal ones stay to keep left most minimum
+            while (stack != 0 && m_arr[start + highest_bit(stack)] > m_arr[pos])
+            {
+                stack ^= std::uint32_t(1) << highest_bit(stack);
+            }
+            stack |= std::uint32_t(1) << (pos - start);
+            m_masks[pos] = stack;
+        }
+    }
+}
+
+/**
+* @brief Finds index of minimum inside one block.
+* @param[in] i_left Left border.
+* @param[in] i_right Right border (in the same block).
+* @return Index of left most minimum.
+*/
+int BlockRMQ::in_block_min(int i_left, int i_right) const
+{
+    const int start = i_left - i_left % BLOCK;
+    // first stack element not before left border
+    const std::uint32_t mask = m_masks[i_right] & (~std::uint32_t(0) << (i_left - start));
+    return start + lowest_bit(mask);
+}
+
+/**
+* @brief Finds minimum of values from array in given range.
+* @param[in] i_left Left border.
+* @param[in] i_right Right border.
+* @return Minimum of given range and its index.
+*/
+MinResult BlockRMQ::get_min(int i_left, int i_right) const
+{
+    if (i_left < 0 || i_right > static_cast<int>(m_arr.size()) - 1 || i_left > i_right)
+    {
+        MinResult invalid = { -1, -1 };
+        return invalid;
+    }
+
+    const int lblock = i_left / BLOCK;
+    const int rblock = i_right / BLOCK;
+
+    int idx = 0;
+    if (lblock == rblock)
+    {
+        idx = in_block_min(i_left, i_right);
+    }
+    else
+    {
+        // tail of left block
+        idx = in_block_min(i_left, lblock * BLOCK + BLOCK - 1);
+
+        // whole blocks in between
+        if (lblock + 1 < rblock)
+        {
+            const int mid = m_block_min[m_blocks.get_min(lblock + 1, rblock - 1).index];
+            if (m_arr[mid] < m_arr[idx])
+            {
+                idx = mid;
+            }
+        }
+
+        // head of right block
+        const int right = in_block_min(rblock * BLOCK, i_right);
+        if (m_arr[right] < m_arr[idx])
+        {
+            idx = right;
+        }
+    }
+
+    MinResult res = { idx, m_arr[idx] };
+    return res;
+}
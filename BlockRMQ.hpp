@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "SparseTable.hpp"
+
+/**
+ * @brief Immutable block decomposed range minimum query, O(n) construction and O(1) query.
+ *
+ * Array is split into blocks of 32 elements. Sparse table over block minima answers
+ * whole blocks, a 32 bit mask of monotonic stack per element answers in-block ranges.
+ */
+class BlockRMQ
+{
+public:
+    /**
+     * @brief Constructs structure from given array.
+     * @param[in] i_arr Input array.
+     */
+    BlockRMQ(const std::vector<int> & i_arr);
+
+    /**
+     * @brief Gets number of elements.
+     */
+    std::size_t size() const
+    {
+        return m_arr.size();
+    }
+
+    /**
+     * @brief Finds minimum of values from array in given range.
+     * @param[in] i_left Left border.
+     * @param[in] i_right Right border.
+     * @return Minimum of given range and its index.
+     */
+    MinResult get_min(int i_left, int i_right) const;
+
+private:
+    /**
+     * @brief Finds index of minimum inside one block.
+     * @param[in] i_left Left border.
+     * @param[in] i_right Right border (in the same block).
+     * @return Index of left most minimum.
+     */
+    int in_block_min(int i_left, int i_right) const;
+
+    std::vector<int> m_arr;              /**< Original array.                        */
+    std::vector<std::uint32_t> m_masks;  /**< Monotonic stack of block per element.  */
+    std::vector<int> m_block_min;        /**< Index of minimum of each block.        */
+    SparseTable m_blocks;                /**< Sparse table over block minima.        */
+};
@@ -0,0 +1,389 @@
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include "IpLpmTable.hpp"
+#include "BoundedDNSCache.hpp"
+
+const std::size_t BoundedDNSCache::WAYS;
+const std::size_t BoundedDNSCache::MAX_URL;
+const std::size_t BoundedDNSCache::URL_WORDS;
+const std::size_t BoundedDNSCache::STRIPES;
+
+namespace
+{
+    /**
+     * @brief Gets current time as number of clock ticks.
+     */
+    BoundedDNSCache::Clock::rep now_ticks()
+    {
+        return BoundedDNSCache::Clock::now().time_since_epoch().count();
+    }
+}
+
+/**
+* @brief Constructs free slot.
+*/
+BoundedDNSCache::Entry::Entry()
+    : version(0)
+    , ip(0)
+    , used(false)
+    , referenced(false)
+    , url_size(0)
+    , expires(0)
+{
+    for (std::size_t pos = 0; pos < URL_WORDS; ++pos)
+    {
+        url[pos].store(0, std::memory_order_relaxed);
+    }
+}
+
+/**
+* @brief Constructor.
+* @param[in] i_capacity Maximal number of entries, rounded up to multiple of WAYS.
+* @param[in] i_ttl Default time to live of entry.
+*/
+BoundedDNSCache::BoundedDNSCache(std::size_t i_capacity, Clock::duration i_ttl)
+    : m_num_sets((i_capacity + WAYS - 1) / WAYS)
+    , m_ttl(i_ttl)
+    , m_entries(new Entry[m_num_sets * WAYS])
+    , m_hands(new std::uint8_t[m_num_sets]())
+    , m_size(0)
+    , m_evictions(0)
+    , m_expirations(0)
+{
+    for (std::size_t pos = 0; pos < STRIPES; ++pos)
+    {
+        m_counters[pos].hits.store(0, std::memory_order_relaxed);
+        m_counters[pos].misses.store(0, std::memory_order_relaxed);
+    }
+}
+
+/**
+* @brief Gets index of first slot of set of address.
+*/
+std::size_t BoundedDNSCache::set_of(std::uint32_t i_ip) const
+{
+    // multiplicative hash mapped to range of sets without division
+    const std::uint64_t hash = static_cast<std::uint32_t>(i_ip * 0x9E3779B1u);
+    return static_cast<std::size_t>((hash * m_num_sets) >> 32) * WAYS;
+}
+
+/**
+* @brief Gets counters of current thread.
+*/
+BoundedDNSCache::Counters & BoundedDNSCache::counters() const
+{
+    static thread_local const std::size_t stripe = std::hash<std::thread::id>()(std::this_thread::get_id()) % STRIPES;
+    return m_counters[stripe];
+}
+
+/**
+* @brief Finds live slot of address, lock should be held.
+* @return Index of slot or capacity if address is missing.
+*/
+std::size_t BoundedDNSCache::find(std::uint32_t i_ip) const
+{
+    const std::size_t first = set_of(i_ip);
+    for (std::size_t slot = first; slot < first + WAYS; ++slot)
+    {
+        if (m_entries[slot].used.load(std::memory_order_relaxed) && m_entries[slot].ip.load(std::memory_order_relaxed) == i_ip)
+        {
+            return slot;
+        }
+    }
+    return capacity();
+}
+
+/**
+* @brief Writes slot, lock should be held.
+*/
+void BoundedDNSCache::store(std::size_t i_slot, std::uint32_t i_ip, std::string_view i_url, Clock::rep i_expires)
+{
+    Entry & entry = m_entries[i_slot];
+
+    // odd version tells readers that slot is being changed
+    const std::uint32_t version = entry.version.load(std::memory_order_relaxed);
+    entry.version.store(version + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    entry.ip.store(i_ip, std::memory_order_relaxed);
+    entry.used.store(true, std::memory_order_relaxed);
+    entry.url_size.store(static_cast<std::uint32_t>(i_url.size()), std::memory_order_relaxed);
+    entry.expires.store(i_expires, std::memory_order_relaxed);
+    for (std::size_t pos = 0; pos * 8 < i_url.size(); ++pos)
+    {
+        std::uint64_t word = 0;
+        std::memcpy(&word, i_url.data() + pos * 8, std::min<std::size_t>(8, i_url.size() - pos * 8));
+        entry.url[pos].store(word, std::memory_order_relaxed);
+    }
+
+    entry.version.store(version + 2, std::memory_order_release);
+}
+
+/**
+* @brief Frees slot, lock should be held.
+*/
+void BoundedDNSCache::release(std::size_t i_slot)
+{
+    Entry & entry = m_entries[i_slot];
+
+    const std::uint32_t version = entry.version.load(std::memory_order_relaxed);
+    entry.version.store(version + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    entry.used.store(false, std::memory_order_relaxed);
+    entry.referenced.store(false, std::memory_order_relaxed);
+
+    entry.version.store(version + 2, std::memory_order_release);
+    m_size.fetch_sub(1, std::memory_order_relaxed);
+}
+
+/**
+* @brief Finds slot for new entry in set of address, evicts entry if set is full.
+* @param[in] i_ip Packed IPv4 address.
+* @param[in] i_now Current time.
+* @return Index of free slot.
+*/
+std::size_t BoundedDNSCache::acquire(std::uint32_t i_ip, Clock::rep i_now)
+{
+    const std::size_t first = set_of(i_ip);
+    for (std::size_t slot = first; slot < first + WAYS; ++slot)
+    {
+        if (!m_entries[slot].used.load(std::memory_order_relaxed))
+        {
+            return slot;
+        }
+    }
+
+    // second chance for referenced entries, at most two turns
+    std::uint8_t & hand = m_hands[first / WAYS];
+    for (;;)
+    {
+        const std::size_t slot = first + hand;
+        hand = static_cast<std::uint8_t>((hand + 1) % WAYS);
+
+        Entry & entry = m_entries[slot];
+        if (entry.expires.load(std::memory_order_relaxed) <= i_now)
+        {
+            m_expirations++;
+            release(slot);
+            return slot;
+        }
+        if (!entry.referenced.load(std::memory_order_relaxed))
+        {
+            m_evictions++;
+            release(slot);
+            return slot;
+        }
+        entry.referenced.store(false, std::memory_order_relaxed);
+    }
+}
+
+/**
+* @brief Adds IP address and corresponding URL.
+* @param[in] i_ip Packed IPv4 address.
+* @param[in] i_url URL.
+* @param[in] i_ttl Time to live of entry.
+* @return False if URL is longer than MAX_URL or cache has no slots.
+*/
+bool BoundedDNSCache::insert(std::uint32_t i_ip, std::string_view i_url, Clock::duration i_ttl)
+{
+    if (m_num_sets == 0 || i_url.size() > MAX_URL)
+    {
+        return false;
+    }
+
+    const Clock::rep expires = now_ticks() + i_ttl.count();
+    std::lock_guard<std::mutex> lock(m_lock);
+
+    std::size_t slot = find(i_ip);
+    if (slot == capacity())
+    {
+        slot = acquire(i_ip, now_ticks());
+        m_size.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // new entry starts without reference, so it isn't kept longer than old ones
+    store(slot, i_ip, i_url, expires);
+    return true;
+}
+
+/**
+* @brief Adds dotted IP address and corresponding URL with default TTL.
+* @param[in] i_ip IP address.
+* @param[in] i_url URL.
+* @return False if address is invalid or entry can't be stored.
+*/
+bool BoundedDNSCache::insert(std::string_view i_ip, std::string_view i_url)
+{
+    std::uint32_t ip = 0;
+    if (!parse_ipv4(i_ip, ip))
+    {
+        return false;
+    }
+
+    return insert(ip, i_url);
+}
+
+/**
+* @brief Reverse DNS search, doesn't take lock.
+* @param[in] i_ip Packed IPv4 address.
+* @return URL or nothing if entry is missing or expired.
+*/
+std::optional<std::string> BoundedDNSCache::search(std::uint32_t i_ip) const
+{
+    const Clock::rep now = now_ticks();
+    Counters & cnt = counters();
+
+    const std::size_t first = (m_num_sets > 0) ? set_of(i_ip) : 0;
+    for (std::size_t slot = first; slot < first + WAYS && m_num_sets > 0; ++slot)
+    {
+        const Entry & entry = m_entries[slot];
+
+        // copy slot, retry if writer has changed it meanwhile
+        for (;;)
+        {
+            const std::uint32_t version = entry.version.load(std::memory_order_acquire);
+            if (version & 1)
+            {
+                continue;
+            }
+
+            const bool match = entry.used.load(std::memory_order_relaxed) && entry.ip.load(std::memory_order_relaxed) == i_ip;
+            Clock::rep expires = 0;
+            std::size_t size = 0;
+            std::uint64_t url[URL_WORDS];
+            if (match)
+            {
+                expires = entry.expires.load(std::memory_order_relaxed);
+                size = entry.url_size.load(std::memory_order_relaxed);
+                for (std::size_t pos = 0; pos * 8 < size && pos < URL_WORDS; ++pos)
+                {
+                    url[pos] = entry.url[pos].load(std::memory_order_relaxed);
+                }
+            }
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (entry.version.load(std::memory_order_relaxed) != version)
+            {
+                continue;
+            }
+
+            if (!match)
+            {
+                break;
+            }
+
+            // expired entry is removed later by clock hand or purge
+            if (expires <= now)
+            {
+                cnt.misses.fetch_add(1, std::memory_order_relaxed);
+                return std::nullopt;
+            }
+
+            // avoid writing shared cache line if bit is already set
+            if (!entry.referenced.load(std::memory_order_relaxed))
+            {
+                entry.referenced.store(true, std::memory_order_relaxed);
+            }
+
+            cnt.hits.fetch_add(1, std::memory_order_relaxed);
+            return std::string(reinterpret_cast<const char *>(url), size);
+        }
+    }
+
+    cnt.misses.fetch_add(1, std::memory_order_relaxed);
+    return std::nullopt;
+}
+
+/**
+* @brief Reverse DNS search by dotted IP address, doesn't take lock.
+* @param[in] i_ip IP address.
+* @return URL or nothing if address is invalid, missing or expired.
+*/
+std::optional<std::string> BoundedDNSCache::search(std::string_view i_ip) const
+{
+    std::uint32_t ip = 0;
+    if (!parse_ipv4(i_ip, ip))
+    {
+        counters().misses.fetch_add(1, std::memory_order_relaxed);
+        return std::nullopt;
+    }
+
+    return search(ip);
+}
+
+/**
+* @brief Removes entry.
+* @param[in] i_ip Packed IPv4 address.
+* @return True if entry was present.
+*/
+bool BoundedDNSCache::erase(std::uint32_t i_ip)
+{
+    if (m_num_sets == 0)
+    {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(m_lock);
+
+    const std::size_t slot = find(i_ip);
+    if (slot == capacity())
+    {
+        return false;
+    }
+
+    release(slot);
+    return true;
+}
+
+/**
+* @brief Removes all expired entries.
+* @return Number of removed entries.
+*/
+std::size_t BoundedDNSCache::purge_expired()
+{
+    const Clock::rep now = now_ticks();
+    std::lock_guard<std::mutex> lock(m_lock);
+
+    std::size_t res = 0;
+    for (std::size_t pos = 0; pos < capacity(); ++pos)
+    {
+        if (m_entries[pos].used.load(std::memory_order_relaxed) && m_entries[pos].expires.load(std::memory_order_relaxed) <= now)
+        {
+            release(pos);
+            res++;
+        }
+    }
+
+    m_expirations += res;
+    return res;
+}
+
+/**
+* @brief Gets counters of cache.
+*/
+BoundedDNSCache::Stats BoundedDNSCache::stats() const
+{
+    Stats res = { 0, 0, 0, 0 };
+    for (std::size_t pos = 0; pos < STRIPES; ++pos)
+    {
+        res.hits += m_counters[pos].hits.load(std::memory_order_relaxed);
+        res.misses += m_counters[pos].misses.load(std::memory_order_relaxed);
+    }
+
+    std::lock_guard<std::mutex> lock(m_lock);
+    res.evictions = m_evictions;
+    res.expirations = m_expirations;
+    return res;
+}
@@ -0,0 +1,221 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+
+/**
+ * @brief Reverse DNS cache with fixed capacity, CLOCK eviction and TTL.
+ *
+ * Entries are kept in preallocated array of slots grouped into sets of WAYS
+ * slots, address can be stored only in its set, so array itself is index and
+ * URLs are stored inline in slots. Memory doesn't change after construction.
+ *
+ * Lookups don't take lock: every slot has version which is odd while writer
+ * changes slot, reader copies slot and retries if version has changed. Reader
+ * only sets reference bit of entry and updates counters striped by threads.
+ * Writers are serialized by mutex. Insertion of new address into full set
+ * moves clock hand of set over its slots: expired entry or entry without
+ * reference bit is evicted, reference bits of other entries are cleared.
+ */
+class BoundedDNSCache
+{
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    /**
+     * @brief Number of slots in set.
+     */
+    static const std::size_t WAYS = 8;
+
+    /**
+     * @brief Maximal length of URL, DNS names are not longer.
+     */
+    static const std::size_t MAX_URL = 255;
+
+    /**
+     * @brief Counters of cache.
+     */
+    struct Stats
+    {
+        std::uint64_t hits;           /**< Successful lookups.             */
+        std::uint64_t misses;         /**< Lookups of missing entries.     */
+        std::uint64_t evictions;      /**< Live entries evicted by CLOCK.  */
+        std::uint64_t expirations;    /**< Expired entries removed.        */
+    };
+
+    /**
+     * @brief Constructor.
+     * @param[in] i_capacity Maximal number of entries, rounded up to multiple of WAYS.
+     * @param[in] i_ttl Default time to live of entry.
+     */
+    BoundedDNSCache(std::size_t i_capacity, Clock::duration i_ttl);
+
+    BoundedDNSCache(const BoundedDNSCache &) = delete;
+    BoundedDNSCache & operator=(const BoundedDNSCache &) = delete;
+
+    /**
+     * @brief Adds IP address and corresponding URL with default TTL.
+     * @param[in] i_ip Packed IPv4 address.
+     * @param[in] i_url URL.
+     * @return False if URL is longer than MAX_URL or cache has no slots.
+     */
+    bool insert(std::uint32_t i_ip, std::string_view i_url)
+    {
+        return insert(i_ip, i_url, m_ttl);
+    }
+
+    /**
+     * @brief Adds IP address and corresponding URL.
+     * @param[in] i_ip Packed IPv4 address.
+     * @param[in] i_url URL.
+     * @param[in] i_ttl Time to live of entry.
+     * @return False if URL is longer than MAX_URL or cache has no slots.
+     */
+    bool insert(std::uint32_t i_ip, std::string_view i_url, Clock::duration i_ttl);
+
+    /**
+     * @brief Adds dotted IP address and corresponding URL with default TTL.
+     * @param[in] i_ip IP address.
+     * @param[in] i_url URL.
+     * @return False if address is invalid or entry can't be stored.
+     */
+    bool insert(std::string_view i_ip, std::string_view i_url);
+
+    /**
+     * @brief Reverse DNS search, doesn't take lock.
+     * @param[in] i_ip Packed IPv4 address.
+     * @return URL or nothing if entry is missing or expired.
+     */
+    std::optional<std::string> search(std::uint32_t i_ip) const;
+
+    /**
+     * @brief Reverse DNS search by dotted IP address, doesn't take lock.
+     * @param[in] i_ip IP address.
+     * @return URL or nothing if address is invalid, missing or expired.
+     */
+    std::optional<std::string> search(std::string_view i_ip) const;
+
+    /**
+     * @brief Removes entry.
+     * @param[in] i_ip Packed IPv4 address.
+     * @return True if entry was present.
+     */
+    bool erase(std::uint32_t i_ip);
+
+    /**
+     * @brief Removes all expired entries.
+     * @return Number of removed entries.
+     */
+    std::size_t purge_expired();
+
+    /**
+     * @brief Gets number of entries (including expired ones not yet removed).
+     */
+    std::size_t size() const
+    {
+        return m_size.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Gets maximal number of entries.
+     */
+    std::size_t capacity() const
+    {
+        return m_num_sets * WAYS;
+    }
+
+    /**
+     * @brief Gets counters of cache.
+     */
+    Stats stats() const;
+
+private:
+    /**
+     * @brief Number of words of inline URL.
+     */
+    static const std::size_t URL_WORDS = (MAX_URL + 8) / 8;
+
+    /**
+     * @brief Number of stripes of lookup counters.
+     */
+    static const std::size_t STRIPES = 16;
+
+    /**
+     * @brief Slot of cache, all fields are atomic so readers may copy slot while it changes.
+     */
+    struct Entry
+    {
+        std::atomic<std::uint32_t> version;             /**< Odd while slot is written.    */
+        std::atomic<std::uint32_t> ip;                  /**< Packed IPv4 address.          */
+        std::atomic<bool> used;                         /**< Indicates live slot.          */
+        mutable std::atomic<bool> referenced;           /**< CLOCK reference bit.          */
+        std::atomic<std::uint32_t> url_size;            /**< Length of URL.                */
+        std::atomic<Clock::rep> expires;                /**< Expiration time.              */
+        std::atomic<std::uint64_t> url[URL_WORDS];      /**< URL stored inline.            */
+
+        /**
+         * @brief Constructs free slot.
+         */
+        Entry();
+    };
+
+    /**
+     * @brief Lookup counters of group of threads, each group has own cache line.
+     */
+    struct alignas(64) Counters
+    {
+        std::atomic<std::uint64_t> hits;                /**< Successful lookups.           */
+        std::atomic<std::uint64_t> misses;              /**< Failed lookups.               */
+    };
+
+    /**
+     * @brief Gets index of first slot of set of address.
+     */
+    std::size_t set_of(std::uint32_t i_ip) const;
+
+    /**
+     * @brief Finds live slot of address, lock should be held.
+     * @return Index of slot or capacity if address is missing.
+     */
+    std::size_t find(std::uint32_t i_ip) const;
+
+    /**
+     * @brief Writes slot, lock should be held.
+     */
+    void store(std::size_t i_slot, std::uint32_t i_ip, std::string_view i_url, Clock::rep i_expires);
+
+    /**
+     * @brief Frees slot, lock should be held.
+     */
+    void release(std::size_t i_slot);
+
+    /**
+     * @brief Finds slot for new entry in set of address, evicts entry if set is full.
+     * @param[in] i_ip Packed IPv4 address.
+     * @param[in] i_now Current time.
+     * @return Index of free slot.
+     */
+    std::size_t acquire(std::uint32_t i_ip, Clock::rep i_now);
+
+    /**
+     * @brief Gets counters of current thread.
+     */
+    Counters & counters() const;
+
+    std::size_t m_num_sets;                                   /**< Number of sets.               */
+    Clock::duration m_ttl;                                    /**< Default time to live.         */
+    std::unique_ptr<Entry[]> m_entries;                       /**< Slots grouped by sets.        */
+    std::unique_ptr<std::uint8_t[]> m_hands;                  /**< Clock hands of sets.          */
+    std::atomic<std::size_t> m_size;                          /**< Number of entries.            */
+    mutable std::mutex m_lock;                                /**< Serializes writers.           */
+    mutable Counters m_counters[STRIPES];                     /**< Lookup counters.              */
+    std::uint64_t m_evictions;                                /**< Evicted live entries.         */
+    std::uint64_t m_expirations;                              /**< Removed expired entries.      */
+};
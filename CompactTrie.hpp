@@ -0,0 +1,450 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Alphabet of lowercase latin letters.
+ */
+struct LowercaseAlphabet
+{
+    static const std::size_t size = 26;
+
+    /**
+     * @brief Position of character in alphabet (out of range for other characters).
+     */
+    static std::size_t index(char i_chr)
+    {
+        return static_cast<std::size_t>(static_cast<unsigned char>(i_chr) - 'a');
+    }
+};
+
+/**
+ * @brief Alphabet of decimal digits.
+ */
+struct DigitAlphabet
+{
+    static const std::size_t size = 10;
+
+    /**
+     * @brief Position of character in alphabet (out of range for other characters).
+     */
+    static std::size_t index(char i_chr)
+    {
+        return static_cast<std::size_t>(static_cast<unsigned char>(i_chr) - '0');
+    }
+};
+
+/**
+ * @brief Alphabet of all bytes.
+ */
+struct ByteAlphabet
+{
+    static const std::size_t size = 256;
+
+    /**
+     * @brief Position of character in alphabet.
+     */
+    static std::size_t index(char i_chr)
+    {
+        return static_cast<unsigned char>(i_chr);
+    }
+};
+
+/**
+ * @brief Compact Trie: arena allocated nodes with 32-bit indices and bitmap+popcount children.
+ *
+ * Node keeps bitmap of present characters and offset of its packed children in
+ * shared edge arena, child for character c is at rank of c in bitmap.
+ * Released nodes and edge blocks are reused, whole trie is freed at once.
+ *
+ * @tparam Alphabet Maps characters to 0..Alphabet::size-1.
+ */
+template<class Alphabet = LowercaseAlphabet>
+class CompactTrie
+{
+public:
+    /**
+     * @brief Constructor.
+     */
+    CompactTrie()
+        : m_count(0)
+        , m_keys(0)
+    {
+        clear();
+    }
+
+    /**
+     * @brief Removes all keys and releases arenas.
+     */
+    void clear()
+    {
+        std::vector<Node>().swap(m_nodes);
+        std::vector<std::uint32_t>().swap(m_edges);
+        std::vector<std::uint32_t>().swap(m_free_nodes);
+        m_free_edges = std::vector<std::vector<std::uint32_t>>(CLASSES);
+        m_count = 0;
+        m_keys = 0;
+
+        // root node
+        alloc_node();
+    }
+
+    /**
+     * @brief Gets number of keys in Trie.
+     */
+    std::size_t size() const
+    {
+        return m_keys;
+    }
+
+    /**
+     * @brief Gets number of used nodes.
+     */
+    std::size_t num_nodes() const
+    {
+        return m_nodes.size() - m_free_nodes.size();
+    }
+
+    /**
+     * @brief Adds new key to Trie.
+     * @param[in] i_key Key to be added (keys with characters out of alphabet are ignored).
+     */
+    void insert(const std::string & i_key)
+    {
+        for (std::size_t level = 0; level < i_key.size(); ++level)
+        {
+            if (Alphabet::index(i_key[level]) >= Alphabet::size)
+            {
+                return;
+            }
+        }
+
+        // increase number of keys
+        m_count++;
+
+        std::uint32_t node = ROOT;
+        for (std::size_t level = 0; level < i_key.size(); ++level)
+        {
+            const std::size_t idx = Alphabet::index(i_key[level]);
+            std::uint32_t next = child(node, idx);
+            if (next == NIL)
+            {
+                // create new node
+                next = alloc_node();
+                add_child(node, idx, next);
+            }
+            // move to next node
+            node = next;
+        }
+
+        if (m_nodes[node].value == 0)
+        {
+            m_keys++;
+        }
+
+        // mark last node as leaf
+        m_nodes[node].value = static_cast<int>(m_count);
+    }
+
+    /**
+     * @brief Searches key in Trie.
+     * @param[in] i_key Key to be searched.
+     * @return True if key is present in Trie or False otherwise.
+     */
+    bool search(const std::string & i_key) const
+    {
+        const std::uint32_t node = find(i_key);
+        return node != NIL && m_nodes[node].value > 0;
+    }
+
+    /**
+     * @brief Removes key from Trie.
+     * @param[in] i_key Given key.
+     */
+    void delete_key(const std::string & i_key)
+    {
+        // nodes on path to key
+        std::vector<std::uint32_t> path(1, ROOT);
+        for (std::size_t level = 0; level < i_key.size(); ++level)
+        {
+            const std::size_t idx = Alphabet::index(i_key[level]);
+            const std::uint32_t next = (idx < Alphabet::size) ? child(path.back(), idx) : NIL;
+            if (next == NIL)
+            {
+                return;
+            }
+            path.push_back(next);
+        }
+
+        if (m_nodes[path.back()].value == 0)
+        {
+            return;
+        }
+
+        // unmark leaf node
+        m_nodes[path.back()].value = 0;
+        m_keys--;
+
+        // remove nodes which are not needed anymore, bottom-up
+        for (std::size_t level = i_key.size(); level > 0; --level)
+        {
+            const std::uint32_t node = path[level];
+            if (m_nodes[node].value > 0 || num_children(node) > 0)
+            {
+                break;
+            }
+            remove_child(path[level - 1], Alphabet::index(i_key[level - 1]));
+            free_node(node);
+        }
+    }
+
+    /**
+     * @brief Finds longest prefix of input string which is in Trie keys.
+     * @param[in] i_key Key to be searched.
+     * @return Key from Trie which is longest prefix of input key.
+     */
+    std::string longest_prefix(const std::string & i_key) const
+    {
+        std::uint32_t node = ROOT;
+        std::size_t prev_pos = 0;
+
+        // traverse string
+        for (std::size_t level = 0; level < i_key.size(); ++level)
+        {
+            const std::size_t idx = Alphabet::index(i_key[level]);
+            node = (idx < Alphabet::size) ? child(node, idx) : NIL;
+            if (node == NIL)
+            {
+                break;
+            }
+
+            // store prevoius matching prefix
+            if (m_nodes[node].value > 0)
+            {
+                prev_pos = level + 1;
+            }
+        }
+
+        return i_key.substr(0, prev_pos);
+    }
+
+private:
+    /**
+     * @brief Number of 64-bit words in children bitmap.
+     */
+    static const std::size_t WORDS = (Alphabet::size + 63) / 64;
+
+    /**
+     * @brief Number of edge block size classes (1, 2, 4, ... children).
+     */
+    static const std::size_t CLASSES = 10;
+
+    static const std::uint32_t NIL = 0xFFFFFFFFu;   /**< Index of missing node.   */
+    static const std::uint32_t ROOT = 0;            /**< Index of root node.      */
+
+    /**
+     * @brief Definition of Trie node.
+     */
+    struct Node
+    {
+        std::uint64_t bitmap[WORDS];    /**< Present characters.                  */
+        std::uint32_t children;         /**< Offset of children in edge arena.    */
+        std::uint32_t capacity;         /**< Size class of edge block.            */
+        int value;                      /**< Value stored in node.                */
+    };
+
+    /**
+     * @brief Number of set bits.
+     */
+    static std::size_t popcount(std::uint64_t i_word)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_popcountll(i_word);
+#else
+        std::size_t res = 0;
+        for (; i_word != 0; i_word &= i_word - 1)
+        {
+            res++;
+        }
+        return res;
+#endif
+    }
+
+    /**
+     * @brief Number of present characters less than given one.
+     */
+    std::size_t rank(std::uint32_t i_node, std::size_t i_idx) const
+    {
+        const Node & node = m_nodes[i_node];
+        std::size_t res = 0;
+        for (std::size_t word = 0; word < i_idx / 64; ++word)
+        {
+            res += popcount(node.bitmap[word]);
+        }
+        const std::uint64_t below = (std::uint64_t(1) << (i_idx % 64)) - 1;
+        return res + popcount(node.bitmap[i_idx / 64] & below);
+    }
+
+    /**
+     * @brief Gets number of children of node.
+     */
+    std::size_t num_children(std::uint32_t i_node) const
+    {
+        std::size_t res = 0;
+        for (std::size_t word = 0; word < WORDS; ++word)
+        {
+            res += popcount(m_nodes[i_node].bitmap[word]);
+        }
+        return res;
+    }
+
+    /**
+     * @brief Gets child for given character or NIL.
+     */
+    std::uint32_t child(std::uint32_t i_node, std::size_t i_idx) const
+    {
+        const Node & node = m_nodes[i_node];
+        if (((node.bitmap[i_idx / 64] >> (i_idx % 64)) & 1) == 0)
+        {
+            return NIL;
+        }
+        return m_edges[node.children + rank(i_node, i_idx)];
+    }
+
+    /**
+     * @brief Follows key from root.
+     * @return Last node of key or NIL.
+     */
+    std::uint32_t find(const std::string & i_key) const
+    {
+        std::uint32_t node = ROOT;
+        for (std::size_t level = 0; level < i_key.size() && node != NIL; ++level)
+        {
+            const std::size_t idx = Alphabet::index(i_key[level]);
+            node = (idx < Alphabet::size) ? child(node, idx) : NIL;
+        }
+        return node;
+    }
+
+    /**
+     * @brief Allocates empty node.
+     */
+    std::uint32_t alloc_node()
+    {
+        Node node = {};
+        node.children = NIL;
+
+        if (!m_free_nodes.empty())
+        {
+            const std::uint32_t idx = m_free_nodes.back();
+            m_free_nodes.pop_back();
+            m_nodes[idx] = node;
+            return idx;
+        }
+
+        m_nodes.push_back(node);
+        return static_cast<std::uint32_t>(m_nodes.size() - 1);
+    }
+
+    /**
+     * @brief Returns node and its edge block to free lists.
+     */
+    void free_node(std::uint32_t i_node)
+    {
+        if (m_nodes[i_node].children != NIL)
+        {
+            m_free_edges[m_nodes[i_node].capacity].push_back(m_nodes[i_node].children);
+        }
+        m_free_nodes.push_back(i_node);
+    }
+
+    /**
+     * @brief Allocates edge block of given size class.
+     */
+    std::uint32_t alloc_edges(std::uint32_t i_class)
+    {
+        if (!m_free_edges[i_class].empty())
+        {
+            const std::uint32_t offset = m_free_edges[i_class].back();
+            m_free_edges[i_class].pop_back();
+            return offset;
+        }
+
+        const std::uint32_t offset = static_cast<std::uint32_t>(m_edges.size());
+        m_edges.resize(m_edges.size() + (std::size_t(1) << i_class), NIL);
+        return offset;
+    }
+
+    /**
+     * @brief Links new child for given character.
+     */
+    void add_child(std::uint32_t i_node, std::size_t i_idx, std::uint32_t i_child)
+    {
+        const std::size_t count = num_children(i_node);
+        const std::size_t pos = rank(i_node, i_idx);
+
+        // grow edge block
+        if (m_nodes[i_node].children == NIL || count == (std::size_t(1) << m_nodes[i_node].capacity))
+        {
+            const std::uint32_t cls = (m_nodes[i_node].children == NIL) ? 0 : m_nodes[i_node].capacity + 1;
+            const std::uint32_t offset = alloc_edges(cls);
+            for (std::size_t edge = 0; edge < count; ++edge)
+            {
+                m_edges[offset + edge] = m_edges[m_nodes[i_node].children + edge];
+            }
+            if (m_nodes[i_node].children != NIL)
+            {
+                m_free_edges[m_nodes[i_node].capacity].push_back(m_nodes[i_node].children);
+            }
+            m_nodes[i_node].children = offset;
+            m_nodes[i_node].capacity = cls;
+        }
+
+        // keep children ordered by character
+        const std::uint32_t base = m_nodes[i_node].children;
+        for (std::size_t edge = count; edge > pos; --edge)
+        {
+            m_edges[base + edge] = m_edges[base + edge - 1];
+        }
+        m_edges[base + pos] = i_child;
+        m_nodes[i_node].bitmap[i_idx / 64] |= std::uint64_t(1) << (i_idx % 64);
+    }
+
+    /**
+     * @brief Unlinks child for given character.
+     */
+    void remove_child(std::uint32_t i_node, std::size_t i_idx)
+    {
+        const std::size_t count = num_children(i_node);
+        const std::size_t pos = rank(i_node, i_idx);
+        const std::uint32_t base = m_nodes[i_node].children;
+
+        for (std::size_t edge = pos; edge + 1 < count; ++edge)
+        {
+            m_edges[base + edge] = m_edges[base + edge + 1];
+        }
+        m_nodes[i_node].bitmap[i_idx / 64] &= ~(std::uint64_t(1) << (i_idx % 64));
+    }
+
+    std::vector<Node> m_nodes;                              /**< Arena of nodes.                 */
+    std::vector<std::uint32_t> m_edges;                     /**< Arena of children blocks.       */
+    std::vector<std::uint32_t> m_free_nodes;                /**< Released nodes.                 */
+    std::vector<std::vector<std::uint32_t>> m_free_edges;   /**< Released blocks by size class.  */
+    std::size_t m_count;                                    /**< Number of insertions.           */
+    std::size_t m_keys;                                     /**< Number of keys in Trie.         */
+};
+
+template<class Alphabet>
+const std::size_t CompactTrie<Alphabet>::WORDS;
+
+template<class Alphabet>
+const std::size_t CompactTrie<Alphabet>::CLASSES;
+
+template<class Alphabet>
+const std::uint32_t CompactTrie<Alphabet>::NIL;
+
+template<class Alphabet>
+const std::uint32_t CompactTrie<Alphabet>::ROOT;
@@ -0,0 +1,338 @@
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <functional>
+#include <vector>
+
+#include "ConcurrentTrie.hpp"
+
+const std::size_t ConcurrentTrie::BLOCK_READERS;
+
+namespace
+{
+    /**
+     * @brief Calculates position of character in alphabet.
+     * @param[in] i_chr Input character.
+     * @return Position of character in alphabet.
+     */
+    int key_to_idx(const char i_chr)
+    {
+        return i_chr - 'a';
+    }
+
+    /**
+     * @brief Counts children of node.
+     */
+    std::size_t num_children(const ConcurrentTrie::Node * i_node, std::size_t i_size)
+    {
+        std::size_t res = 0;
+        for (std::size_t pos = 0; pos < i_size; ++pos)
+        {
+            if (i_node->child[pos].load(std::memory_order_relaxed) != nullptr)
+            {
+                res++;
+            }
+        }
+        return res;
+    }
+}
+
+/**
+* @brief Constructor.
+* @param[in] i_size Alphabet size.
+*/
+ConcurrentTrie::ConcurrentTrie(const std::size_t i_size)
+    : m_root(new Node(i_size))
+    , m_count(0)
+    , m_size(i_size)
+    , m_epoch(1)
+    , m_slots(new SlotBlock(nullptr))
+{}
+
+/**
+* @brief Destructor, there should be no active readers.
+*/
+ConcurrentTrie::~ConcurrentTrie()
+{
+    for (std::size_t pos = 0; pos < m_retired.size(); ++pos)
+    {
+        delete m_retired[pos].second;
+    }
+    free_tree(m_root);
+
+    for (SlotBlock * block = m_slots.load(std::memory_order_relaxed); block != nullptr;)
+    {
+        SlotBlock * next = block->next;
+        delete block;
+        block = next;
+    }
+}
+
+/**
+* @brief Frees node and all its descendants.
+*/
+void ConcurrentTrie::free_tree(Node * i_node)
+{
+    std::vector<Node *> stack(1, i_node);
+    while (!stack.empty())
+    {
+        Node * node = stack.back();
+        stack.pop_back();
+        for (std::size_t pos = 0; pos < m_size; ++pos)
+        {
+            Node * next = node->child[pos].load(std::memory_order_relaxed);
+            if (next != nullptr)
+            {
+                stack.push_back(next);
+            }
+        }
+        delete node;
+    }
+}
+
+/**
+* @brief Announces reader in free slot, adds block of slots if all are taken.
+* @return Slot of reader.
+*/
+ConcurrentTrie::ReaderSlot * ConcurrentTrie::enter() const
+{
+    const std::uint64_t epoch = m_epoch.load(std::memory_order_seq_cst);
+
+    // start from slot of current thread, probe next ones if it is taken
+    const std::size_t start = std::hash<std::thread::id>()(std::this_thread::get_id()) % BLOCK_READERS;
+
+    SlotBlock * head = m_slots.load(std::memory_order_seq_cst);
+    for (SlotBlock * block = head; block != nullptr; block = block->next)
+    {
+        for (std::size_t cnt = 0; cnt < BLOCK_READERS; ++cnt)
+        {
+            ReaderSlot & slot = block->slots[(start + cnt) % BLOCK_READERS];
+            std::uint64_t expected = 0;
+            if (slot.epoch.load(std::memory_order_relaxed) == 0 &&
+                slot.epoch.compare_exchange_strong(expected, epoch, std::memory_order_seq_cst))
+            {
+                return &slot;
+            }
+        }
+    }
+
+    // all slots are taken, add block with slot already announced; reclaim which
+    // doesn't see block yet has unlinked its nodes before reader can reach them
+    SlotBlock * block = new SlotBlock(head);
+    block->slots[0].epoch.store(epoch, std::memory_order_relaxed);
+
+    // push block, link to next block is updated to current head on failure
+    while (!m_slots.compare_exchange_weak(block->next, block, std::memory_order_seq_cst))
+    {
+    }
+
+    return &block->slots[0];
+}
+
+/**
+* @brief Releases reader slot.
+* @param[in] i_slot Slot of reader.
+*/
+void ConcurrentTrie::leave(ReaderSlot * i_slot) const
+{
+    i_slot->epoch.store(0, std::memory_order_release);
+}
+
+/**
+* @brief Frees removed nodes which can't be reached by active readers.
+*/
+void ConcurrentTrie::reclaim()
+{
+    // readers which entered from now on can't see removed nodes
+    const std::uint64_t epoch = m_epoch.fetch_add(1, std::memory_order_seq_cst);
+
+    // oldest epoch announced by active reader
+    std::uint64_t oldest = epoch + 1;
+    for (SlotBlock * block = m_slots.load(std::memory_order_seq_cst); block != nullptr; block = block->next)
+    {
+        for (std::size_t pos = 0; pos < BLOCK_READERS; ++pos)
+        {
+            const std::uint64_t slot = block->slots[pos].epoch.load(std::memory_order_seq_cst);
+            if (slot != 0 && slot < oldest)
+            {
+                oldest = slot;
+            }
+        }
+    }
+
+    // keep nodes which may be used by active readers
+    std::size_t kept = 0;
+    for (std::size_t pos = 0; pos < m_retired.size(); ++pos)
+    {
+        if (m_retired[pos].first < oldest)
+        {
+            delete m_retired[pos].second;
+        }
+        else
+        {
+            m_retired[kept++] = m_retired[pos];
+        }
+    }
+    m_retired.resize(kept);
+}
+
+/**
+* @brief Adds new key to trie.
+* @param[in] i_key Key to be added.
+*/
+void ConcurrentTrie::insert(const std::string & i_key)
+{
+    std::lock_guard<std::mutex> lock(m_write_lock);
+
+    // increase number of keys
+    m_count++;
+
+    // follow existing part of key
+    Node * node = m_root;
+    std::size_t level = 0;
+    for (; level < i_key.size(); ++level)
+    {
+        Node * next = node->child[key_to_idx(i_key[level])].load(std::memory_order_relaxed);
+        if (next == nullptr)
+        {
+            break;
+        }
+        node = next;
+    }
+
+    if (level == i_key.size())
+    {
+        // mark existing node as leaf
+        node->value.store(static_cast<int>(m_count), std::memory_order_release);
+        return;
+    }
+
+    // build rest of key privately
+    Node * branch = new Node(m_size);
+    Node * last = branch;
+    for (std::size_t pos = level + 1; pos < i_key.size(); ++pos)
+    {
+        Node * next = new Node(m_size);
+        last->child[key_to_idx(i_key[pos])].store(next, std::memory_order_relaxed);
+        last = next;
+    }
+    last->value.store(static_cast<int>(m_count), std::memory_order_relaxed);
+
+    // publish whole branch at once
+    node->child[key_to_idx(i_key[level])].store(branch, std::memory_order_release);
+}
+
+/**
+* @brief Searches key in trie, doesn't block.
+* @param[in] i_key Key to be searched.
+* @return True if key is present in trie or False otherwise.
+*/
+bool ConcurrentTrie::search(const std::string & i_key) const
+{
+    ReaderSlot * slot = enter();
+
+    const Node * node = m_root;
+    for (std::size_t level = 0; level < i_key.size() && node != nullptr; ++level)
+    {
+        node = node->child[key_to_idx(i_key[level])].load(std::memory_order_acquire);
+    }
+    const bool res = (node != nullptr) && (node->value.load(std::memory_order_acquire) > 0);
+
+    leave(slot);
+    return res;
+}
+
+/**
+* @brief Removes key from trie.
+* @param[in] i_key Given key.
+*/
+void ConcurrentTrie::delete_key(const std::string & i_key)
+{
+    std::lock_guard<std::mutex> lock(m_write_lock);
+
+    // nodes on path of key
+    std::vector<Node *> path(1, m_root);
+    for (std::size_t level = 0; level < i_key.size(); ++level)
+    {
+        Node * next = path.back()->child[key_to_idx(i_key[level])].load(std::memory_order_relaxed);
+        if (next == nullptr)
+        {
+            return;
+        }
+        path.push_back(next);
+    }
+
+    if (path.back()->value.load(std::memory_order_relaxed) <= 0)
+    {
+        return;
+    }
+
+    // unmark leaf node
+    path.back()->value.store(0, std::memory_order_release);
+
+    // node with children stays in trie
+    std::size_t top = path.size() - 1;
+    if (top == 0 || num_children(path[top], m_size) > 0)
+    {
+        return;
+    }
+
+    // highest node whose subtree contains only removed key
+    while (top > 1 && path[top - 1]->value.load(std::memory_order_relaxed) <= 0 && num_children(path[top - 1], m_size) == 1)
+    {
+        top--;
+    }
+
+    // unlink chain, readers which are inside it may finish their walk
+    path[top - 1]->child[key_to_idx(i_key[top - 1])].store(nullptr, std::memory_order_release);
+
+    const std::uint64_t epoch = m_epoch.load(std::memory_order_relaxed);
+    for (std::size_t pos = top; pos < path.size(); ++pos)
+    {
+        m_retired.push_back(std::make_pair(epoch, path[pos]));
+    }
+
+    reclaim();
+}
+
+/**
+* @brief Finds longest prefix of input string which is in trie keys, doesn't block.
+* @param[in] i_key Key to be searched.
+* @return Key from trie which is longest prefix of input key.
+*/
+std::string ConcurrentTrie::longest_prefix(const std::string & i_key) const
+{
+    ReaderSlot * slot = enter();
+
+    std::size_t prev_pos = 0;
+    const Node * node = m_root;
+    for (std::size_t level = 0; level < i_key.size(); ++level)
+    {
+        node = node->child[key_to_idx(i_key[level])].load(std::memory_order_acquire);
+        if (node == nullptr)
+        {
+            break;
+        }
+
+        // store previous matching prefix
+        if (node->value.load(std::memory_order_acquire) > 0)
+        {
+            prev_pos = level + 1;
+        }
+    }
+
+    leave(slot);
+    return i_key.substr(0, prev_pos);
+}
+
+/**
+* @brief Gets number of removed nodes which wait for reclamation.
+*/
+std::size_t ConcurrentTrie::num_retired() const
+{
+    std::lock_guard<std::mutex> lock(m_write_lock);
+    return m_retired.size();
+}
@@ -0,0 +1,166 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Trie for concurrent readers and background writers.
+ *
+ * Readers never take a lock: child pointers and values are atomic, new
+ * branches are built privately and published by single release store.
+ * Writers are serialized by internal mutex. Removed nodes are reclaimed by
+ * epochs: every reader announces global epoch in its slot while it walks the
+ * trie, node unlinked in epoch e is freed once all active readers have
+ * announced epochs greater than e. Slots are added in blocks when all are
+ * taken, so number of concurrent readers is not limited.
+ */
+class ConcurrentTrie
+{
+public:
+    /**
+     * @brief Definition of trie node.
+     */
+    struct Node
+    {
+        std::atomic<int> value;            /**< Value stored in node.   */
+        std::atomic<Node *> * child;       /**< Children of node.       */
+
+        /**
+         * @brief Constructor.
+         * @param[in] i_size Alphabet size.
+         */
+        Node(const std::size_t i_size)
+            : value(0)
+            , child(new std::atomic<Node *>[i_size])
+        {
+            for (std::size_t pos = 0; pos < i_size; ++pos)
+            {
+                child[pos].store(nullptr, std::memory_order_relaxed);
+            }
+        }
+
+        /**
+         * @brief Destructor.
+         */
+        ~Node()
+        {
+            delete[] child;
+        }
+    };
+
+    /**
+     * @brief Constructor.
+     * @param[in] i_size Alphabet size.
+     */
+    ConcurrentTrie(const std::size_t i_size);
+
+    /**
+     * @brief Destructor, there should be no active readers.
+     */
+    ~ConcurrentTrie();
+
+    ConcurrentTrie(const ConcurrentTrie &) = delete;
+    ConcurrentTrie & operator=(const ConcurrentTrie &) = delete;
+
+    /**
+     * @brief Adds new key to trie.
+     * @param[in] i_key Key to be added.
+     */
+    void insert(const std::string & i_key);
+
+    /**
+     * @brief Searches key in trie, doesn't block.
+     * @param[in] i_key Key to be searched.
+     * @return True if key is present in trie or False otherwise.
+     */
+    bool search(const std::string & i_key) const;
+
+    /**
+     * @brief Removes key from trie.
+     * @param[in] i_key Given key.
+     */
+    void delete_key(const std::string & i_key);
+
+    /**
+     * @brief Finds longest prefix of input string which is in trie keys, doesn't block.
+     * @param[in] i_key Key to be searched.
+     * @return Key from trie which is longest prefix of input key.
+     */
+    std::string longest_prefix(const std::string & i_key) const;
+
+    /**
+     * @brief Gets number of removed nodes which wait for reclamation.
+     */
+    std::size_t num_retired() const;
+
+private:
+    /**
+     * @brief Number of reader slots in block.
+     */
+    static const std::size_t BLOCK_READERS = 64;
+
+    /**
+     * @brief Epoch announced by reader, 0 if slot is free.
+     */
+    struct alignas(64) ReaderSlot
+    {
+        std::atomic<std::uint64_t> epoch;  /**< Announced epoch.        */
+    };
+
+    /**
+     * @brief Block of reader slots, blocks are added when all slots are taken.
+     */
+    struct SlotBlock
+    {
+        ReaderSlot slots[BLOCK_READERS];   /**< Reader slots.           */
+        SlotBlock * next;                  /**< Previously added block. */
+
+        /**
+         * @brief Constructs block of free slots.
+         * @param[in] i_next Previously added block.
+         */
+        SlotBlock(SlotBlock * i_next)
+            : next(i_next)
+        {
+            for (std::size_t pos = 0; pos < BLOCK_READERS; ++pos)
+            {
+                slots[pos].epoch.store(0, std::memory_order_relaxed);
+            }
+        }
+    };
+
+    /**
+     * @brief Announces reader in free slot, adds block of slots if all are taken.
+     * @return Slot of reader.
+     */
+    ReaderSlot * enter() const;
+
+    /**
+     * @brief Releases reader slot.
+     * @param[in] i_slot Slot of reader.
+     */
+    void leave(ReaderSlot * i_slot) const;
+
+    /**
+     * @brief Frees removed nodes which can't be reached by active readers.
+     */
+    void reclaim();
+
+    /**
+     * @brief Frees node and all its descendants.
+     */
+    void free_tree(Node * i_node);
+
+    Node * m_root;                                              /**< Root of trie.                    */
+    std::size_t m_count;                                        /**< Number of insertions.            */
+    std::size_t m_size;                                         /**< Alphabet size.                   */
+    mutable std::mutex m_write_lock;                            /**< Serializes writers.              */
+    std::atomic<std::uint64_t> m_epoch;                         /**< Global epoch.                    */
+    mutable std::atomic<SlotBlock *> m_slots;                   /**< Epochs of active readers.        */
+    std::vector<std::pair<std::uint64_t, Node *>> m_retired;    /**< Removed nodes with their epochs. */
+};
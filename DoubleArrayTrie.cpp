@@ -0,0 +1,273 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <algorithm>
+
+#include "DoubleArrayTrie.hpp"
+
+namespace
+{
+    /**
+     * @brief Signature of serialized trie.
+     */
+    const std::uint32_t MAGIC = 0x31544144; // "DAT1"
+
+    /**
+     * @brief Header of serialized trie.
+     */
+    struct Header
+    {
+        std::uint32_t magic;    /**< Signature.         */
+        std::uint32_t size;     /**< Number of slots.   */
+    };
+
+    /**
+     * @brief Code of key character at given depth, 0 marks end of key.
+     */
+    std::uint32_t code_at(const std::string & i_key, std::size_t i_depth)
+    {
+        return (i_depth < i_key.size()) ? static_cast<unsigned char>(i_key[i_depth]) + 1 : 0;
+    }
+}
+
+/**
+* @brief Constructs empty trie.
+*/
+DoubleArrayTrie::DoubleArrayTrie()
+    : m_base(nullptr)
+    , m_check(nullptr)
+    , m_size(0)
+    , m_next_free(1)
+{}
+
+/**
+* @brief Builds trie from set of keys.
+* @param[in] i_keys Keys, value of key is its index in sorted set of keys.
+*/
+DoubleArrayTrie::DoubleArrayTrie(const std::vector<std::string> & i_keys)
+    : m_base(nullptr)
+    , m_check(nullptr)
+    , m_size(0)
+    , m_next_free(1)
+{
+    std::vector<std::string> keys = i_keys;
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+    // root is slot 0
+    reserve(256);
+    m_check_data[0] = 0;
+
+    if (!keys.empty())
+    {
+        build_util(keys, 0, keys.size(), 0, 0);
+    }
+
+    // drop unused tail
+    std::size_t used = m_check_data.size();
+    while (used > 1 && m_check_data[used - 1] < 0)
+    {
+        used--;
+    }
+    m_base_data.resize(used);
+    m_check_data.resize(used);
+
+    m_base = m_base_data.data();
+    m_check = m_check_data.data();
+    m_size = used;
+}
+
+/**
+* @brief Extends arrays up to given size.
+*/
+void DoubleArrayTrie::reserve(std::size_t i_size)
+{
+    if (i_size > m_check_data.size())
+    {
+        m_base_data.resize(i_size, 0);
+        // -1 marks free slot
+        m_check_data.resize(i_size, -1);
+    }
+}
+
+/**
+* @brief Helper function, places children of node and builds their subtrees.
+*/
+void DoubleArrayTrie::build_util(const std::vector<std::string> & i_keys, std::size_t i_begin, std::size_t i_end, std::size_t i_depth, std::int32_t i_node)
+{
+    // distinct codes of children with ranges of their keys, keys are sorted
+    std::vector<std::uint32_t> codes;
+    std::vector<std::size_t> starts;
+    for (std::size_t pos = i_begin; pos < i_end; ++pos)
+    {
+        const std::uint32_t code = code_at(i_keys[pos], i_depth);
+        if (codes.empty() || codes.back() != code)
+        {
+            codes.push_back(code);
+            starts.push_back(pos);
+        }
+    }
+    starts.push_back(i_end);
+
+    // skip occupied prefix of arrays
+    while (m_next_free < m_check_data.size() && m_check_data[m_next_free] >= 0)
+    {
+        m_next_free++;
+    }
+
+    // find base where all children fit into free slots
+    std::size_t base = (m_next_free > codes[0]) ? m_next_free - codes[0] : 1;
+    for (;; ++base)
+    {
+        if (base == 0)
+        {
+            continue;
+        }
+
+        reserve(base + codes.back() + 1);
+        if (m_check_data[base + codes[0]] >= 0)
+        {
+            continue;
+        }
+
+        bool fits = true;
+        for (std::size_t idx = 1; idx < codes.size() && fits; ++idx)
+        {
+            fits = m_check_data[base + codes[idx]] < 0;
+        }
+
+        if (fits)
+        {
+            break;
+        }
+    }
+
+    // occupy slots of children
+    m_base_data[i_node] = static_cast<std::int32_t>(base);
+    for (std::size_t idx = 0; idx < codes.size(); ++idx)
+    {
+        m_check_data[base + codes[idx]] = i_node;
+    }
+
+    // build subtrees
+    for (std::size_t idx = 0; idx < codes.size(); ++idx)
+    {
+        const std::int32_t child = static_cast<std::int32_t>(base + codes[idx]);
+        if (codes[idx] == 0)
+        {
+            // end of key, store value
+            m_base_data[child] = -static_cast<std::int32_t>(starts[idx]) - 1;
+        }
+        else
+        {
+            build_util(i_keys, starts[idx], starts[idx + 1], i_depth + 1, child);
+        }
+    }
+}
+
+/**
+* @brief Creates trie which uses serialized buffer in place (e.g. mmapped file).
+* @param[in] i_data Buffer created by serialize(), aligned to 4 bytes.
+* @param[in] i_bytes Size of buffer.
+* @return Trie which refers to buffer, empty trie if buffer is invalid.
+*/
+DoubleArrayTrie DoubleArrayTrie::view(const void * i_data, std::size_t i_bytes)
+{
+    DoubleArrayTrie res;
+
+    if (i_data == nullptr || i_bytes < sizeof(Header))
+    {
+        return res;
+    }
+
+    Header header;
+    std::memcpy(&header, i_data, sizeof(Header));
+    if (header.magic != MAGIC || i_bytes < sizeof(Header) + 2 * sizeof(std::int32_t) * header.size)
+    {
+        return res;
+    }
+
+    const std::int32_t * arrays = reinterpret_cast<const std::int32_t *>(static_cast<const char *>(i_data) + sizeof(Header));
+    res.m_base = arrays;
+    res.m_check = arrays + header.size;
+    res.m_size = header.size;
+
+    return res;
+}
+
+/**
+* @brief Searches key in trie.
+* @param[in] i_key Key to be searched.
+* @return Value of key or -1 if key is not present.
+*/
+int DoubleArrayTrie::exact_match(const std::string & i_key) const
+{
+    if (m_size == 0)
+    {
+        return -1;
+    }
+
+    std::int32_t node = 0;
+    for (std::size_t level = 0; level < i_key.size(); ++level)
+    {
+        node = next(node, static_cast<unsigned char>(i_key[level]) + 1);
+        if (node < 0)
+        {
+            return -1;
+        }
+    }
+
+    // key ends at current node
+    const std::int32_t leaf = next(node, 0);
+    return (leaf >= 0) ? -m_base[leaf] - 1 : -1;
+}
+
+/**
+* @brief Finds longest prefix of input string which is in trie keys.
+* @param[in] i_key Key to be searched.
+* @return Key from trie which is longest prefix of input key.
+*/
+std::string DoubleArrayTrie::longest_prefix(const std::string & i_key) const
+{
+    std::size_t len = 0;
+    common_prefixes(i_key, [&len](std::size_t i_len, int) { len = i_len; });
+    return i_key.substr(0, len);
+}
+
+/**
+* @brief Serializes trie into flat buffer.
+* @return Header followed by BASE and CHECK arrays.
+*/
+std::vector<char> DoubleArrayTrie::serialize() const
+{
+    const Header header = { MAGIC, static_cast<std::uint32_t>(m_size) };
+    const std::size_t bytes = m_size * sizeof(std::int32_t);
+
+    std::vector<char> res(sizeof(Header) + 2 * bytes);
+    std::memcpy(res.data(), &header, sizeof(Header));
+    if (m_size > 0)
+    {
+        std::memcpy(res.data() + sizeof(Header), m_base, bytes);
+        std::memcpy(res.data() + sizeof(Header) + bytes, m_check, bytes);
+    }
+
+    return res;
+}
+
+/**
+* @brief Writes serialized trie to file.
+* @param[in] i_path Path to file.
+* @return True on success.
+*/
+bool DoubleArrayTrie::save(const std::string & i_path) const
+{
+    const std::vector<char> buffer = serialize();
+
+    std::ofstream out(i_path.c_str(), std::ios::binary);
+    out.write(buffer.data(), buffer.size());
+
+    return static_cast<bool>(out);
+}
@@ -0,0 +1,164 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Static double-array trie (BASE/CHECK arrays) for byte strings.
+ *
+ * Transition from node s by byte c goes to t = BASE[s] + c + 1 and is valid
+ * if CHECK[t] == s, end of key is marked by transition with code 0 whose BASE
+ * keeps value of key. Arrays can be serialized into flat buffer and queried in place.
+ */
+class DoubleArrayTrie
+{
+public:
+    /**
+     * @brief Builds trie from set of keys.
+     * @param[in] i_keys Keys, value of key is its index in sorted set of keys.
+     */
+    DoubleArrayTrie(const std::vector<std::string> & i_keys);
+
+    DoubleArrayTrie(const DoubleArrayTrie &) = delete;
+    DoubleArrayTrie & operator=(const DoubleArrayTrie &) = delete;
+    DoubleArrayTrie(DoubleArrayTrie &&) = default;
+    DoubleArrayTrie & operator=(DoubleArrayTrie &&) = default;
+
+    /**
+     * @brief Creates trie which uses serialized buffer in place (e.g. mmapped file).
+     * @param[in] i_data Buffer created by serialize(), aligned to 4 bytes.
+     * @param[in] i_bytes Size of buffer.
+     * @return Trie which refers to buffer, empty trie if buffer is invalid.
+     */
+    static DoubleArrayTrie view(const void * i_data, std::size_t i_bytes);
+
+    /**
+     * @brief Gets number of slots in arrays.
+     */
+    std::size_t size() const
+    {
+        return m_size;
+    }
+
+    /**
+     * @brief Searches key in trie.
+     * @param[in] i_key Key to be searched.
+     * @return Value of key or -1 if key is not present.
+     */
+    int exact_match(const std::string & i_key) const;
+
+    /**
+     * @brief Searches key in trie.
+     * @param[in] i_key Key to be searched.
+     * @return True if key is present in trie or False otherwise.
+     */
+    bool search(const std::string & i_key) const
+    {
+        return exact_match(i_key) >= 0;
+    }
+
+    /**
+     * @brief Finds longest prefix of input string which is in trie keys.
+     * @param[in] i_key Key to be searched.
+     * @return Key from trie which is longest prefix of input key.
+     */
+    std::string longest_prefix(const std::string & i_key) const;
+
+    /**
+     * @brief Enumerates all keys which are prefixes of input string.
+     * @tparam Func Type of function.
+     * @param[in] i_key Key to be searched.
+     * @param[in] func Function called with (prefix length, value) for each key, shortest first.
+     */
+    template<class Func>
+    void common_prefixes(const std::string & i_key, Func func) const;
+
+    /**
+     * @brief Serializes trie into flat buffer.
+     * @return Header followed by BASE and CHECK arrays.
+     */
+    std::vector<char> serialize() const;
+
+    /**
+     * @brief Writes serialized trie to file.
+     * @param[in] i_path Path to file.
+     * @return True on success.
+     */
+    bool save(const std::string & i_path) const;
+
+private:
+    /**
+     * @brief Constructs empty trie.
+     */
+    DoubleArrayTrie();
+
+    /**
+     * @brief Follows transition from node by code.
+     * @return Next node or -1.
+     */
+    std::int32_t next(std::int32_t i_node, std::uint32_t i_code) const
+    {
+        const std::int64_t t = static_cast<std::int64_t>(m_base[i_node]) + i_code;
+        if (t <= 0 || t >= static_cast<std::int64_t>(m_size) || m_check[t] != i_node)
+        {
+            return -1;
+        }
+        return static_cast<std::int32_t>(t);
+    }
+
+    /**
+     * @brief Helper function, places children of node and builds their subtrees.
+     */
+    void build_util(const std::vector<std::string> & i_keys, std::size_t i_begin, std::size_t i_end, std::size_t i_depth, std::int32_t i_node);
+
+    /**
+     * @brief Extends arrays up to given size.
+     */
+    void reserve(std::size_t i_size);
+
+    std::vector<std::int32_t> m_base_data;    /**< Own BASE array.                     */
+    std::vector<std::int32_t> m_check_data;   /**< Own CHECK array.                    */
+    const std::int32_t * m_base;              /**< BASE array (own or external).       */
+    const std::int32_t * m_check;             /**< CHECK array (own or external).      */
+    std::size_t m_size;                       /**< Number of slots.                    */
+    std::size_t m_next_free;                  /**< First slot to try during build.     */
+};
+
+/**
+* @brief Enumerates all keys which are prefixes of input string.
+* @tparam Func Type of function.
+* @param[in] i_key Key to be searched.
+* @param[in] func Function called with (prefix length, value) for each key, shortest first.
+*/
+template<class Func>
+inline void DoubleArrayTrie::common_prefixes(const std::string & i_key, Func func) const
+{
+    if (m_size == 0)
+    {
+        return;
+    }
+
+    std::int32_t node = 0;
+    for (std::size_t level = 0; ; ++level)
+    {
+        // key ends at current node
+        const std::int32_t leaf = next(node, 0);
+        if (leaf >= 0)
+        {
+            func(level, -m_base[leaf] - 1);
+        }
+
+        if (level == i_key.size())
+        {
+            break;
+        }
+
+        node = next(node, static_cast<unsigned char>(i_key[level]) + 1);
+        if (node < 0)
+        {
+            break;
+        }
+    }
+}
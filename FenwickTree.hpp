@@ -0,0 +1,419 @@
+#pragma once
+
+#include <cstddef>
+#include <array>
+#include <vector>
+
+/**
+ * @brief Fenwick tree core: point update and prefix sum.
+ * @tparam ValueType Type of values stored in tree.
+ */
+template<class ValueType>
+class FenwickTree
+{
+public:
+    /**
+     * @brief Constructs empty tree.
+     * @param[in] i_size Number of elements.
+     */
+    FenwickTree(const std::size_t i_size)
+        : m_tree(std::vector<ValueType>(i_size + 1, ValueType()))
+        , m_size(i_size)
+    {}
+
+    /**
+     * @brief Constructs tree from given array in linear time.
+     * @param[in] i_arr Array of values.
+     */
+    FenwickTree(const std::vector<ValueType> & i_arr)
+        : m_tree(std::vector<ValueType>(i_arr.size() + 1, ValueType()))
+        , m_size(i_arr.size())
+    {
+        for (std::size_t pos = 1; pos <= m_size; ++pos)
+        {
+            m_tree[pos] += i_arr[pos - 1];
+            // push partial sum to parent node
+            const std::size_t parent = update_next(pos);
+            if (parent <= m_size)
+            {
+                m_tree[parent] += m_tree[pos];
+            }
+        }
+    }
+
+    /**
+     * @brief Gets number of elements.
+     */
+    std::size_t size() const
+    {
+        return m_size;
+    }
+
+    /**
+     * @brief Gets next node of update path, node covering range of given node (1-based).
+     */
+    static std::size_t update_next(std::size_t i_pos)
+    {
+        return i_pos + (i_pos & (0 - i_pos));
+    }
+
+    /**
+     * @brief Gets next node of query path, node covering range just before given node (1-based).
+     */
+    static std::size_t query_next(std::size_t i_pos)
+    {
+        return i_pos - (i_pos & (0 - i_pos));
+    }
+
+    /**
+     * @brief Adds value to element at given index.
+     * @param[in] i_idx Index in array.
+     * @param[in] i_delta Value to be added.
+     */
+    void add(std::size_t i_idx, const ValueType & i_delta)
+    {
+        add_path(i_idx + 1, i_delta, m_size);
+    }
+
+    /**
+     * @brief Adds value to nodes of update path which starts at given node, up to last node.
+     * @note Paths from nodes of aligned range (a * 2^k, (a + 1) * 2^k] leave it only
+     *       through node (a + 1) * 2^k. Such ranges can be updated independently and
+     *       the rest of their paths once per range.
+     * @param[in] i_node First node of path (1-based).
+     * @param[in] i_delta Value to be added.
+     * @param[in] i_last Last node which may be updated.
+     */
+    void add_path(std::size_t i_node, const ValueType & i_delta, std::size_t i_last)
+    {
+        const std::size_t last = (i_last < m_size) ? i_last : m_size;
+        for (; i_node <= last; i_node = update_next(i_node))
+        {
+            m_tree[i_node] += i_delta;
+        }
+    }
+
+    /**
+     * @brief Gets sum of values in range 0..idx.
+     * @param[in] i_idx Right most index.
+     * @return Sum of range.
+     */
+    ValueType prefix_sum(std::size_t i_idx) const
+    {
+        ValueType s = ValueType();
+        for (++i_idx; i_idx > 0; i_idx = query_next(i_idx))
+        {
+            s += m_tree[i_idx];
+        }
+        return s;
+    }
+
+    /**
+     * @brief Gets sum of values in range left..right.
+     * @param[in] i_left Left border.
+     * @param[in] i_right Right border.
+     * @return Sum of range.
+     */
+    ValueType range_sum(std::size_t i_left, std::size_t i_right) const
+    {
+        if (i_left == 0)
+        {
+            return prefix_sum(i_right);
+        }
+        return prefix_sum(i_right) - prefix_sum(i_left - 1);
+    }
+
+    /**
+     * @brief Finds smallest index whose prefix sum is not less than given value.
+     * @note All values in array should be non-negative.
+     * @param[in] i_sum Required prefix sum.
+     * @return Index in array or size if there is no such index.
+     */
+    std::size_t lower_bound(ValueType i_sum) const
+    {
+        if (!(ValueType() < i_sum))
+        {
+            return 0;
+        }
+
+        // highest power of two not greater than size
+        std::size_t step = 1;
+        while (step <= m_size / 2)
+        {
+            step *= 2;
+        }
+
+        // descend from root, pos is largest index with prefix sum less than i_sum
+        std::size_t pos = 0;
+        for (; step > 0; step /= 2)
+        {
+            if (pos + step <= m_size && m_tree[pos + step] < i_sum)
+            {
+                pos += step;
+                i_sum -= m_tree[pos];
+            }
+        }
+
+        return pos;
+    }
+
+private:
+    std::vector<ValueType> m_tree;    /**< Data stored in tree (1-based). */
+    std::size_t m_size;               /**< Number of elements.            */
+};
+
+/**
+ * @brief Fenwick tree with range update and range sum (two trees trick).
+ * @tparam ValueType Type of values stored in tree.
+ */
+template<class ValueType>
+class RangeFenwickTree
+{
+public:
+    /**
+     * @brief Constructs zero filled tree.
+     * @param[in] i_size Number of elements.
+     */
+    RangeFenwickTree(const std::size_t i_size)
+        : m_mul(i_size + 1)
+        , m_add(i_size + 1)
+        , m_size(i_size)
+    {}
+
+    /**
+     * @brief Constructs tree from given array.
+     * @param[in] i_arr Array of values.
+     */
+    RangeFenwickTree(const std::vector<ValueType> & i_arr)
+        : m_mul(i_arr.size() + 1)
+        , m_add(i_arr)
+        , m_size(i_arr.size())
+    {}
+
+    /**
+     * @brief Gets number of elements.
+     */
+    std::size_t size() const
+    {
+        return m_size;
+    }
+
+    /**
+     * @brief Adds value to all elements in range left..right.
+     * @param[in] i_left Left border.
+     * @param[in] i_right Right border.
+     * @param[in] i_delta Value to be added.
+     */
+    void range_add(std::size_t i_left, std::size_t i_right, const ValueType & i_delta)
+    {
+        // prefix(i) = mul(i) * (i + 1) + add(i)
+        m_mul.add(i_left, i_delta);
+        m_mul.add(i_right + 1, ValueType() - i_delta);
+        m_add.add(i_left, ValueType() - i_delta * static_cast<ValueType>(i_left));
+        m_add.add(i_right + 1, i_delta * static_cast<ValueType>(i_right + 1));
+    }
+
+    /**
+     * @brief Gets sum of values in range 0..idx.
+     * @param[in] i_idx Right most index.
+     * @return Sum of range.
+     */
+    ValueType prefix_sum(std::size_t i_idx) const
+    {
+        return m_mul.prefix_sum(i_idx) * static_cast<ValueType>(i_idx + 1) + m_add.prefix_sum(i_idx);
+    }
+
+    /**
+     * @brief Gets sum of values in range left..right.
+     * @param[in] i_left Left border.
+     * @param[in] i_right Right border.
+     * @return Sum of range.
+     */
+    ValueType range_sum(std::size_t i_left, std::size_t i_right) const
+    {
+        if (i_left == 0)
+        {
+            return prefix_sum(i_right);
+        }
+        return prefix_sum(i_right) - prefix_sum(i_left - 1);
+    }
+
+    /**
+     * @brief Gets value of single element.
+     * @param[in] i_idx Index in array.
+     */
+    ValueType get(std::size_t i_idx) const
+    {
+        return range_sum(i_idx, i_idx);
+    }
+
+private:
+    FenwickTree<ValueType> m_mul;     /**< Coefficients of index.    */
+    FenwickTree<ValueType> m_add;     /**< Constant terms.           */
+    std::size_t m_size;               /**< Number of elements.       */
+};
+
+/**
+ * @brief N-dimensional Fenwick tree with point update and box sum.
+ * @tparam ValueType Type of values stored in tree.
+ * @tparam Dim Number of dimensions.
+ */
+template<class ValueType, std::size_t Dim>
+class FenwickTreeND
+{
+public:
+    typedef std::array<std::size_t, Dim> Index;
+
+    /**
+     * @brief Constructs zero filled tree.
+     * @param[in] i_dims Size of each dimension.
+     */
+    FenwickTreeND(const Index & i_dims)
+        : m_dims(i_dims)
+    {
+        static_assert(Dim > 0, "FenwickTreeND requires at least one dimension");
+
+        // row-major strides over (dims + 1) extents
+        std::size_t total = 1;
+        for (std::size_t d = Dim; d-- > 0;)
+        {
+            m_strides[d] = total;
+            total *= m_dims[d] + 1;
+        }
+        m_tree = std::vector<ValueType>(total, ValueType());
+    }
+
+    /**
+     * @brief Gets size of each dimension.
+     */
+    const Index & dims() const
+    {
+        return m_dims;
+    }
+
+    /**
+     * @brief Adds value to element at given point.
+     * @param[in] i_idx Point coordinates.
+     * @param[in] i_delta Value to be added.
+     */
+    void add(const Index & i_idx, const ValueType & i_delta)
+    {
+        add_util(0, 0, i_idx, i_delta);
+    }
+
+    /**
+     * @brief Gets sum of box 0..idx (inclusive in each dimension).
+     * @param[in] i_idx Upper corner of box.
+     * @return Sum of box.
+     */
+    ValueType prefix_sum(const Index & i_idx) const
+    {
+        return prefix_util(0, 0, i_idx);
+    }
+
+    /**
+     * @brief Gets sum of box lo..hi (inclusive in each dimension).
+     * @param[in] i_lo Lower corner of box.
+     * @param[in] i_hi Upper corner of box.
+     * @return Sum of box.
+     */
+    ValueType range_sum(const Index & i_lo, const Index & i_hi) const
+    {
+        ValueType s = ValueType();
+
+        // inclusion-exclusion over 2^Dim corners
+        for (std::size_t mask = 0; mask < (std::size_t(1) << Dim); ++mask)
+        {
+            Index corner;
+            bool empty = false;
+            std::size_t lows = 0;
+            for (std::size_t d = 0; d < Dim; ++d)
+            {
+                if (mask & (std::size_t(1) << d))
+                {
+                    // corner below lower border
+                    if (i_lo[d] == 0)
+                    {
+                        empty = true;
+                        break;
+                    }
+                    corner[d] = i_lo[d] - 1;
+                    lows++;
+                }
+                else
+                {
+                    corner[d] = i_hi[d];
+                }
+            }
+
+            if (empty)
+            {
+                continue;
+            }
+
+            if (lows % 2 == 0)
+            {
+                s += prefix_sum(corner);
+            }
+            else
+            {
+                s -= prefix_sum(corner);
+            }
+        }
+
+        return s;
+    }
+
+private:
+    /**
+     * @brief Helper function, walks update path in given dimension.
+     * @param[in] i_dim Current dimension.
+     * @param[in] i_offset Offset accumulated from previous dimensions.
+     * @param[in] i_idx Point coordinates.
+     * @param[in] i_delta Value to be added.
+     */
+    void add_util(std::size_t i_dim, std::size_t i_offset, const Index & i_idx, const ValueType & i_delta)
+    {
+        for (std::size_t pos = i_idx[i_dim] + 1; pos <= m_dims[i_dim]; pos = FenwickTree<ValueType>::update_next(pos))
+        {
+            const std::size_t offset = i_offset + pos * m_strides[i_dim];
+            if (i_dim + 1 == Dim)
+            {
+                m_tree[offset] += i_delta;
+            }
+            else
+            {
+                add_util(i_dim + 1, offset, i_idx, i_delta);
+            }
+        }
+    }
+
+    /**
+     * @brief Helper function, walks query path in given dimension.
+     * @param[in] i_dim Current dimension.
+     * @param[in] i_offset Offset accumulated from previous dimensions.
+     * @param[in] i_idx Upper corner of box.
+     * @return Partial sum.
+     */
+    ValueType prefix_util(std::size_t i_dim, std::size_t i_offset, const Index & i_idx) const
+    {
+        ValueType s = ValueType();
+        for (std::size_t pos = i_idx[i_dim] + 1; pos > 0; pos = FenwickTree<ValueType>::query_next(pos))
+        {
+            const std::size_t offset = i_offset + pos * m_strides[i_dim];
+            if (i_dim + 1 == Dim)
+            {
+                s += m_tree[offset];
+            }
+            else
+            {
+                s += prefix_util(i_dim + 1, offset, i_idx);
+            }
+        }
+        return s;
+    }
+
+    std::vector<ValueType> m_tree;    /**< Data stored in tree (1-based). */
+    Index m_dims;                     /**< Size of each dimension.        */
+    Index m_strides;                  /**< Stride of each dimension.      */
+};
@@ -0,0 +1,241 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Indexed Binary Heap, keys are addressed by external ids 0..capacity-1.
+ *
+ * Heap stores keys together with their ids and position array maps each id to
+ * its place in heap, so key of any id can be changed or removed in O(log n).
+ *
+ * @tparam KeyType Type of keys stored in heap.
+ * @tparam Compare Ordering of keys, top of heap is the least key.
+ */
+template<class KeyType, class Compare = std::less<KeyType>>
+class IndexedHeap
+{
+public:
+    /**
+     * @brief Constructs empty heap.
+     * @param[in] i_capacity Number of ids.
+     */
+    IndexedHeap(const std::size_t i_capacity)
+        : m_pos(i_capacity, NPOS)
+    {}
+
+    /**
+     * @brief Gets number of keys in heap.
+     */
+    std::size_t size() const
+    {
+        return m_heap.size();
+    }
+
+    /**
+     * @brief Checks whether heap is empty.
+     */
+    bool empty() const
+    {
+        return m_heap.empty();
+    }
+
+    /**
+     * @brief Checks whether id is in heap.
+     * @param[in] i_id Id.
+     */
+    bool contains(const std::size_t i_id) const
+    {
+        return i_id < m_pos.size() && m_pos[i_id] != NPOS;
+    }
+
+    /**
+     * @brief Gets key of id which is in heap.
+     * @param[in] i_id Id.
+     */
+    const KeyType & key(const std::size_t i_id) const
+    {
+        return m_heap[m_pos[i_id]].key;
+    }
+
+    /**
+     * @brief Gets id with the least key.
+     */
+    std::size_t top() const
+    {
+        return m_heap[0].id;
+    }
+
+    /**
+     * @brief Gets the least key.
+     */
+    const KeyType & top_key() const
+    {
+        return m_heap[0].key;
+    }
+
+    /**
+     * @brief Adds id with given key.
+     * @param[in] i_id Id, not in heap.
+     * @param[in] i_key Key.
+     * @return True if id is added or False if id is invalid or already in heap.
+     */
+    bool push(const std::size_t i_id, KeyType i_key)
+    {
+        if (i_id >= m_pos.size() || m_pos[i_id] != NPOS)
+        {
+            return false;
+        }
+
+        m_heap.push_back(Entry{ std::move(i_key), static_cast<std::uint32_t>(i_id) });
+        sift_up(m_heap.size() - 1);
+        return true;
+    }
+
+    /**
+     * @brief Decreases key of id.
+     * @param[in] i_id Id.
+     * @param[in] i_key New key.
+     * @return True if key is changed or False if id is not in heap or new key is not less than current.
+     */
+    bool decrease_key(const std::size_t i_id, KeyType i_key)
+    {
+        if (!contains(i_id) || !m_comp(i_key, m_heap[m_pos[i_id]].key))
+        {
+            return false;
+        }
+
+        m_heap[m_pos[i_id]].key = std::move(i_key);
+        sift_up(m_pos[i_id]);
+        return true;
+    }
+
+    /**
+     * @brief Removes id from heap.
+     * @param[in] i_id Id.
+     * @return True if id is removed or False if id is not in heap.
+     */
+    bool erase(const std::size_t i_id)
+    {
+        if (!contains(i_id))
+        {
+            return false;
+        }
+
+        const std::size_t idx = m_pos[i_id];
+        m_pos[i_id] = NPOS;
+
+        // last entry fills the hole, it may go either up or down
+        if (idx + 1 < m_heap.size())
+        {
+            m_heap[idx] = std::move(m_heap.back());
+            m_heap.pop_back();
+
+            if (idx > 0 && m_comp(m_heap[idx].key, m_heap[(idx - 1) / 2].key))
+            {
+                sift_up(idx);
+            }
+            else
+            {
+                sift_down(idx);
+            }
+        }
+        else
+        {
+            m_heap.pop_back();
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief Removes id with the least key.
+     * @return Removed id.
+     */
+    std::size_t pop()
+    {
+        const std::size_t res = m_heap[0].id;
+        erase(res);
+        return res;
+    }
+
+private:
+    /**
+     * @brief Definition of heap entry.
+     */
+    struct Entry
+    {
+        KeyType key;          /**< Key.                */
+        std::uint32_t id;     /**< Id of key.          */
+    };
+
+    /**
+     * @brief Moves entry up to its place, parents are shifted down into hole.
+     * @param[in] i_idx Index of entry.
+     */
+    void sift_up(std::size_t i_idx)
+    {
+        Entry entry = std::move(m_heap[i_idx]);
+        while (i_idx > 0)
+        {
+            const std::size_t parent = (i_idx - 1) / 2;
+            if (!m_comp(entry.key, m_heap[parent].key))
+            {
+                break;
+            }
+            place(i_idx, std::move(m_heap[parent]));
+            i_idx = parent;
+        }
+        place(i_idx, std::move(entry));
+    }
+
+    /**
+     * @brief Moves entry down to its place, smaller children are shifted up into hole.
+     * @param[in] i_idx Index of entry.
+     */
+    void sift_down(std::size_t i_idx)
+    {
+        const std::size_t size = m_heap.size();
+        Entry entry = std::move(m_heap[i_idx]);
+        for (;;)
+        {
+            std::size_t child = 2 * i_idx + 1;
+            if (child >= size)
+            {
+                break;
+            }
+            if (child + 1 < size && m_comp(m_heap[child + 1].key, m_heap[child].key))
+            {
+                child++;
+            }
+            if (!m_comp(m_heap[child].key, entry.key))
+            {
+                break;
+            }
+            place(i_idx, std::move(m_heap[child]));
+            i_idx = child;
+        }
+        place(i_idx, std::move(entry));
+    }
+
+    /**
+     * @brief Stores entry at given index and updates its position.
+     */
+    void place(std::size_t i_idx, Entry && i_entry)
+    {
+        m_pos[i_entry.id] = static_cast<std::uint32_t>(i_idx);
+        m_heap[i_idx] = std::move(i_entry);
+    }
+
+    static const std::uint32_t NPOS;      /**< Position of ids not in heap.  */
+
+    std::vector<Entry> m_heap;            /**< Binary heap data.             */
+    std::vector<std::uint32_t> m_pos;     /**< Positions of ids in heap.     */
+    Compare m_comp;                       /**< Ordering of keys.             */
+};
+
+template<class KeyType, class Compare>
+const std::uint32_t IndexedHeap<KeyType, Compare>::NPOS = 0xFFFFFFFFu;
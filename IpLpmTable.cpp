@@ -0,0 +1,565 @@
+#include <cstddef>
+#include <cstdint>
+#include <array>
+#include <map>
+#include <optional>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <utility>
+#include <algorithm>
+
+#include "IpLpmTable.hpp"
+
+const std::uint32_t Ipv4LpmTable::MAX_VALUE;
+const std::uint32_t Ipv4LpmTable::VALID;
+const std::uint32_t Ipv4LpmTable::EXTENDED;
+const std::uint32_t Ipv4LpmTable::VALUE_MASK;
+const std::uint32_t Ipv6LpmTable::NIL;
+
+namespace
+{
+    /**
+     * @brief Number of entries in tbl24.
+     */
+    const std::size_t TBL24_SIZE = std::size_t(1) << 24;
+
+    /**
+     * @brief Network mask of IPv4 prefix.
+     */
+    std::uint32_t ipv4_mask(std::uint8_t i_len)
+    {
+        return (i_len == 0) ? 0 : (0xFFFFFFFFu << (32 - i_len));
+    }
+
+    /**
+     * @brief Clears bits of IPv6 address after prefix.
+     */
+    Ipv6Address ipv6_mask(const Ipv6Address & i_addr, std::uint8_t i_len)
+    {
+        Ipv6Address res = i_addr;
+        for (std::size_t pos = 0; pos < res.size(); ++pos)
+        {
+            const std::size_t bits = (i_len > pos * 8) ? i_len - pos * 8 : 0;
+            if (bits < 8)
+            {
+                res[pos] &= static_cast<std::uint8_t>(0xFF00u >> bits);
+            }
+        }
+        return res;
+    }
+
+    /**
+     * @brief Parses groups of hexadecimal digits separated by ':'.
+     * @param[in] i_str Groups, may be empty.
+     * @param[out] o_groups Parsed groups.
+     * @return True if all groups are valid.
+     */
+    bool parse_groups(std::string_view i_str, std::vector<std::uint16_t> & o_groups)
+    {
+        if (i_str.empty())
+        {
+            return true;
+        }
+
+        std::size_t begin = 0;
+        for (;;)
+        {
+            const std::size_t end = std::min(i_str.find(':', begin), i_str.size());
+            if (end == begin || end - begin > 4)
+            {
+                return false;
+            }
+
+            std::uint16_t group = 0;
+            for (std::size_t pos = begin; pos < end; ++pos)
+            {
+                const char chr = i_str[pos];
+                std::uint16_t digit = 0;
+                if (chr >= '0' && chr <= '9')
+                {
+                    digit = chr - '0';
+                }
+                else if (chr >= 'a' && chr <= 'f')
+                {
+                    digit = chr - 'a' + 10;
+                }
+                else if (chr >= 'A' && chr <= 'F')
+                {
+                    digit = chr - 'A' + 10;
+                }
+                else
+                {
+                    return false;
+                }
+                group = static_cast<std::uint16_t>(group * 16 + digit);
+            }
+            o_groups.push_back(group);
+
+            if (end == i_str.size())
+            {
+                return true;
+            }
+            begin = end + 1;
+        }
+    }
+}
+
+/**
+* @brief Parses dotted IPv4 address.
+* @param[in] i_str Address, e.g. "192.168.0.1".
+* @param[out] o_addr Packed address.
+* @return True if address is valid.
+*/
+bool parse_ipv4(std::string_view i_str, std::uint32_t & o_addr)
+{
+    std::uint32_t addr = 0;
+    std::size_t pos = 0;
+
+    for (std::size_t octet = 0; octet < 4; ++octet)
+    {
+        if (octet > 0)
+        {
+            if (pos >= i_str.size() || i_str[pos] != '.')
+            {
+                return false;
+            }
+            pos++;
+        }
+
+        // up to three digits
+        std::uint32_t val = 0;
+        std::size_t digits = 0;
+        while (pos < i_str.size() && i_str[pos] >= '0' && i_str[pos] <= '9' && digits < 3)
+        {
+            val = val * 10 + (i_str[pos] - '0');
+            pos++;
+            digits++;
+        }
+        if (digits == 0 || val > 255)
+        {
+            return false;
+        }
+        addr = (addr << 8) | val;
+    }
+
+    if (pos != i_str.size())
+    {
+        return false;
+    }
+
+    o_addr = addr;
+    return true;
+}
+
+/**
+* @brief Parses IPv6 address, "::" compression is supported.
+* @param[in] i_str Address, e.g. "2001:db8::1".
+* @param[out] o_addr Packed address.
+* @return True if address is valid.
+*/
+bool parse_ipv6(std::string_view i_str, Ipv6Address & o_addr)
+{
+    std::vector<std::uint16_t> head;
+    std::vector<std::uint16_t> tail;
+
+    const std::size_t gap = i_str.find("::");
+    if (gap == std::string_view::npos)
+    {
+        if (!parse_groups(i_str, head) || head.size() != 8)
+        {
+            return false;
+        }
+    }
+    else
+    {
+        // only one gap is allowed and it replaces at least one group
+        if (i_str.find("::", gap + 1) != std::string_view::npos ||
+            !parse_groups(i_str.substr(0, gap), head) || !parse_groups(i_str.substr(gap + 2), tail) ||
+            head.size() + tail.size() > 7)
+        {
+            return false;
+        }
+    }
+
+    // zero groups fill the gap
+    head.resize(8 - tail.size(), 0);
+    head.insert(head.end(), tail.begin(), tail.end());
+
+    for (std::size_t pos = 0; pos < 8; ++pos)
+    {
+        o_addr[2 * pos] = static_cast<std::uint8_t>(head[pos] >> 8);
+        o_addr[2 * pos + 1] = static_cast<std::uint8_t>(head[pos] & 0xFF);
+    }
+    return true;
+}
+
+/**
+* @brief Constructs empty table.
+*/
+Ipv4LpmTable::Ipv4LpmTable()
+    : m_tbl24(TBL24_SIZE, 0)
+    , m_depth24(TBL24_SIZE, 0)
+    , m_rules(33)
+    , m_size(0)
+{}
+
+/**
+* @brief Sets entries in range whose prefixes are not longer than given depth.
+* @param[in] i_begin First entry of tbl8.
+* @param[in] i_count Number of entries.
+* @param[in] i_entry New entry.
+* @param[in] i_depth New depth (prefix length + 1, 0 for no prefix).
+* @param[in] i_max_depth Only entries with depth up to this are changed.
+*/
+void Ipv4LpmTable::fill_tbl8(std::size_t i_begin, std::size_t i_count, std::uint32_t i_entry, std::uint8_t i_depth, std::uint8_t i_max_depth)
+{
+    for (std::size_t pos = i_begin; pos < i_begin + i_count; ++pos)
+    {
+        // longer prefixes stay
+        if (m_depth8[pos] <= i_max_depth)
+        {
+            m_tbl8[pos] = i_entry;
+            m_depth8[pos] = i_depth;
+        }
+    }
+}
+
+/**
+* @brief Sets entries of tbl24 and their groups like fill_tbl8.
+*/
+void Ipv4LpmTable::fill_tbl24(std::size_t i_begin, std::size_t i_count, std::uint32_t i_entry, std::uint8_t i_depth, std::uint8_t i_max_depth)
+{
+    for (std::size_t pos = i_begin; pos < i_begin + i_count; ++pos)
+    {
+        if (m_tbl24[pos] & EXTENDED)
+        {
+            fill_tbl8((m_tbl24[pos] & VALUE_MASK) * 256, 256, i_entry, i_depth, i_max_depth);
+        }
+        else if (m_depth24[pos] <= i_max_depth)
+        {
+            m_tbl24[pos] = i_entry;
+            m_depth24[pos] = i_depth;
+        }
+    }
+}
+
+/**
+* @brief Finds longest stored prefix which covers given prefix and is shorter.
+* @param[in] i_addr Address of prefix.
+* @param[in] i_len Length of prefix.
+* @param[out] o_entry Entry of covering prefix (0 if none).
+* @param[out] o_depth Depth of covering prefix (0 if none).
+*/
+void Ipv4LpmTable::covering(std::uint32_t i_addr, std::uint8_t i_len, std::uint32_t & o_entry, std::uint8_t & o_depth) const
+{
+    for (std::size_t len = i_len; len-- > 0;)
+    {
+        const std::unordered_map<std::uint32_t, std::uint32_t>::const_iterator it = m_rules[len].find(i_addr & ipv4_mask(static_cast<std::uint8_t>(len)));
+        if (it != m_rules[len].end())
+        {
+            o_entry = VALID | it->second;
+            o_depth = static_cast<std::uint8_t>(len + 1);
+            return;
+        }
+    }
+
+    o_entry = 0;
+    o_depth = 0;
+}
+
+/**
+* @brief Adds prefix or replaces its value.
+* @param[in] i_addr Address of prefix.
+* @param[in] i_len Length of prefix (0..32).
+* @param[in] i_value Value, not greater than MAX_VALUE.
+* @return True on success.
+*/
+bool Ipv4LpmTable::insert(std::uint32_t i_addr, std::uint8_t i_len, std::uint32_t i_value)
+{
+    if (i_len > 32 || i_value > MAX_VALUE)
+    {
+        return false;
+    }
+
+    const std::uint32_t addr = i_addr & ipv4_mask(i_len);
+    std::pair<std::unordered_map<std::uint32_t, std::uint32_t>::iterator, bool> res = m_rules[i_len].insert(std::make_pair(addr, i_value));
+    if (res.second)
+    {
+        m_size++;
+    }
+    else
+    {
+        res.first->second = i_value;
+    }
+
+    const std::uint32_t entry = VALID | i_value;
+    const std::uint8_t depth = static_cast<std::uint8_t>(i_len + 1);
+
+    if (i_len <= 24)
+    {
+        fill_tbl24(addr >> 8, std::size_t(1) << (24 - i_len), entry, depth, depth);
+        return true;
+    }
+
+    // long prefix needs group of last 8 bits
+    const std::size_t idx = addr >> 8;
+    if (!(m_tbl24[idx] & EXTENDED))
+    {
+        std::uint32_t group = 0;
+        if (!m_free_groups.empty())
+        {
+            group = m_free_groups.back();
+            m_free_groups.pop_back();
+        }
+        else
+        {
+            group = static_cast<std::uint32_t>(m_tbl8.size() / 256);
+            m_tbl8.resize(m_tbl8.size() + 256);
+            m_depth8.resize(m_depth8.size() + 256);
+        }
+
+        // group inherits entry of short prefix
+        for (std::size_t pos = 0; pos < 256; ++pos)
+        {
+            m_tbl8[group * 256 + pos] = m_tbl24[idx];
+            m_depth8[group * 256 + pos] = m_depth24[idx];
+        }
+        m_tbl24[idx] = EXTENDED | group;
+    }
+
+    const std::size_t group = m_tbl24[idx] & VALUE_MASK;
+    fill_tbl8(group * 256 + (addr & 0xFF), std::size_t(1) << (32 - i_len), entry, depth, depth);
+
+    return true;
+}
+
+/**
+* @brief Removes prefix.
+* @param[in] i_addr Address of prefix.
+* @param[in] i_len Length of prefix (0..32).
+* @return True if prefix was present.
+*/
+bool Ipv4LpmTable::remove(std::uint32_t i_addr, std::uint8_t i_len)
+{
+    if (i_len > 32)
+    {
+        return false;
+    }
+
+    const std::uint32_t addr = i_addr & ipv4_mask(i_len);
+    if (m_rules[i_len].erase(addr) == 0)
+    {
+        return false;
+    }
+    m_size--;
+
+    // entries of prefix go to covering prefix
+    std::uint32_t entry = 0;
+    std::uint8_t depth = 0;
+    covering(addr, i_len, entry, depth);
+
+    const std::uint8_t max_depth = static_cast<std::uint8_t>(i_len + 1);
+    if (i_len <= 24)
+    {
+        fill_tbl24(addr >> 8, std::size_t(1) << (24 - i_len), entry, depth, max_depth);
+        return true;
+    }
+
+    const std::size_t idx = addr >> 8;
+    const std::size_t group = m_tbl24[idx] & VALUE_MASK;
+    fill_tbl8(group * 256 + (addr & 0xFF), std::size_t(1) << (32 - i_len), entry, depth, max_depth);
+
+    // group without long prefixes has the same entry everywhere
+    for (std::size_t pos = 0; pos < 256; ++pos)
+    {
+        if (m_depth8[group * 256 + pos] > 25)
+        {
+            return true;
+        }
+    }
+    m_tbl24[idx] = m_tbl8[group * 256];
+    m_depth24[idx] = m_depth8[group * 256];
+    m_free_groups.push_back(static_cast<std::uint32_t>(group));
+
+    return true;
+}
+
+/**
+* @brief Constructs empty table.
+*/
+Ipv6LpmTable::Ipv6LpmTable()
+    : m_rules(129)
+    , m_size(0)
+{
+    make_node();
+}
+
+/**
+* @brief Allocates node with empty slots.
+* @return Index of node.
+*/
+std::uint32_t Ipv6LpmTable::make_node()
+{
+    const Slot empty = { 0, NIL, 0 };
+    m_slots.resize(m_slots.size() + 256, empty);
+    return static_cast<std::uint32_t>(m_slots.size() / 256 - 1);
+}
+
+/**
+* @brief Finds node which keeps prefixes of given length, creates missing nodes.
+*/
+std::uint32_t Ipv6LpmTable::find_node(const Ipv6Address & i_addr, std::uint8_t i_len, bool i_create)
+{
+    // node of level L keeps lengths 8L+1..8L+8, root also keeps 0
+    const std::size_t level = (i_len == 0) ? 0 : (i_len - 1) / 8;
+
+    std::uint32_t node = 0;
+    for (std::size_t pos = 0; pos < level; ++pos)
+    {
+        std::uint32_t child = m_slots[node * 256 + i_addr[pos]].child;
+        if (child == NIL)
+        {
+            if (!i_create)
+            {
+                return NIL;
+            }
+            child = make_node();
+            m_slots[node * 256 + i_addr[pos]].child = child;
+        }
+        node = child;
+    }
+
+    return node;
+}
+
+/**
+* @brief Adds prefix or replaces its value.
+* @param[in] i_addr Address of prefix.
+* @param[in] i_len Length of prefix (0..128).
+* @param[in] i_value Value.
+* @return True on success.
+*/
+bool Ipv6LpmTable::insert(const Ipv6Address & i_addr, std::uint8_t i_len, std::uint32_t i_value)
+{
+    if (i_len > 128)
+    {
+        return false;
+    }
+
+    const Ipv6Address addr = ipv6_mask(i_addr, i_len);
+    std::pair<std::map<Ipv6Address, std::uint32_t>::iterator, bool> res = m_rules[i_len].insert(std::make_pair(addr, i_value));
+    if (res.second)
+    {
+        m_size++;
+    }
+    else
+    {
+        res.first->second = i_value;
+    }
+
+    // expand prefix to slots of its node
+    const std::size_t level = (i_len == 0) ? 0 : (i_len - 1) / 8;
+    const std::size_t bits = i_len - 8 * level;
+    const std::size_t first = std::size_t(addr[level]);
+    const std::size_t count = std::size_t(1) << (8 - bits);
+    const std::uint8_t depth = static_cast<std::uint8_t>(i_len + 1);
+
+    const std::uint32_t node = find_node(addr, i_len, true);
+    for (std::size_t pos = first; pos < first + count; ++pos)
+    {
+        // longer prefixes stay
+        Slot & slot = m_slots[node * 256 + pos];
+        if (slot.depth <= depth)
+        {
+            slot.value = i_value;
+            slot.depth = depth;
+        }
+    }
+
+    return true;
+}
+
+/**
+* @brief Removes prefix.
+* @param[in] i_addr Address of prefix.
+* @param[in] i_len Length of prefix (0..128).
+* @return True if prefix was present.
+*/
+bool Ipv6LpmTable::remove(const Ipv6Address & i_addr, std::uint8_t i_len)
+{
+    if (i_len > 128)
+    {
+        return false;
+    }
+
+    const Ipv6Address addr = ipv6_mask(i_addr, i_len);
+    if (m_rules[i_len].erase(addr) == 0)
+    {
+        return false;
+    }
+    m_size--;
+
+    // shorter prefix expanded into the same node replaces removed one
+    const std::size_t level = (i_len == 0) ? 0 : (i_len - 1) / 8;
+    const std::size_t lowest = (level == 0) ? 0 : 8 * level + 1;
+    std::uint32_t value = 0;
+    std::uint8_t depth = 0;
+    for (std::size_t len = i_len; len-- > lowest;)
+    {
+        const std::map<Ipv6Address, std::uint32_t>::const_iterator it = m_rules[len].find(ipv6_mask(addr, static_cast<std::uint8_t>(len)));
+        if (it != m_rules[len].end())
+        {
+            value = it->second;
+            depth = static_cast<std::uint8_t>(len + 1);
+            break;
+        }
+    }
+
+    const std::size_t bits = i_len - 8 * level;
+    const std::size_t first = std::size_t(addr[level]);
+    const std::size_t count = std::size_t(1) << (8 - bits);
+    const std::uint8_t max_depth = static_cast<std::uint8_t>(i_len + 1);
+
+    const std::uint32_t node = find_node(addr, i_len, false);
+    for (std::size_t pos = first; pos < first + count; ++pos)
+    {
+        Slot & slot = m_slots[node * 256 + pos];
+        if (slot.depth <= max_depth)
+        {
+            slot.value = value;
+            slot.depth = depth;
+        }
+    }
+
+    return true;
+}
+
+/**
+* @brief Finds value of longest prefix which contains address.
+* @param[in] i_addr Address.
+* @return Value or nothing if no prefix matches.
+*/
+std::optional<std::uint32_t> Ipv6LpmTable::lookup(const Ipv6Address & i_addr) const
+{
+    std::optional<std::uint32_t> res;
+
+    std::uint32_t node = 0;
+    for (std::size_t pos = 0; pos < i_addr.size(); ++pos)
+    {
+        const Slot & slot = m_slots[node * 256 + i_addr[pos]];
+
+        // longer match overrides shorter one
+        if (slot.depth != 0)
+        {
+            res = slot.value;
+        }
+        if (slot.child == NIL)
+        {
+            break;
+        }
+        node = slot.child;
+    }
+
+    return res;
+}
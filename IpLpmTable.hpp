@@ -0,0 +1,218 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <array>
+#include <map>
+#include <optional>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Packed IPv6 address, most significant byte first.
+ */
+typedef std::array<std::uint8_t, 16> Ipv6Address;
+
+/**
+ * @brief Parses dotted IPv4 address.
+ * @param[in] i_str Address, e.g. "192.168.0.1".
+ * @param[out] o_addr Packed address.
+ * @return True if address is valid.
+ */
+bool parse_ipv4(std::string_view i_str, std::uint32_t & o_addr);
+
+/**
+ * @brief Parses IPv6 address, "::" compression is supported.
+ * @param[in] i_str Address, e.g. "2001:db8::1".
+ * @param[out] o_addr Packed address.
+ * @return True if address is valid.
+ */
+bool parse_ipv6(std::string_view i_str, Ipv6Address & o_addr);
+
+/**
+ * @brief IPv4 longest prefix match table (DIR-24-8).
+ *
+ * First 24 bits of address index table of 2^24 entries, entry either keeps
+ * value or refers to group of 256 entries indexed by last 8 bits, so lookup
+ * takes at most two memory accesses. Prefix length of every entry is kept
+ * separately and used only by updates.
+ */
+class Ipv4LpmTable
+{
+public:
+    /**
+     * @brief Maximal value which can be stored in table.
+     */
+    static const std::uint32_t MAX_VALUE = (1u << 30) - 1;
+
+    /**
+     * @brief Constructs empty table.
+     */
+    Ipv4LpmTable();
+
+    /**
+     * @brief Adds prefix or replaces its value.
+     * @param[in] i_addr Address of prefix.
+     * @param[in] i_len Length of prefix (0..32).
+     * @param[in] i_value Value, not greater than MAX_VALUE.
+     * @return True on success.
+     */
+    bool insert(std::uint32_t i_addr, std::uint8_t i_len, std::uint32_t i_value);
+
+    /**
+     * @brief Removes prefix.
+     * @param[in] i_addr Address of prefix.
+     * @param[in] i_len Length of prefix (0..32).
+     * @return True if prefix was present.
+     */
+    bool remove(std::uint32_t i_addr, std::uint8_t i_len);
+
+    /**
+     * @brief Finds value of longest prefix which contains address.
+     * @param[in] i_addr Address.
+     * @return Value or nothing if no prefix matches.
+     */
+    std::optional<std::uint32_t> lookup(std::uint32_t i_addr) const
+    {
+        std::uint32_t entry = m_tbl24[i_addr >> 8];
+        if (entry & EXTENDED)
+        {
+            entry = m_tbl8[(entry & VALUE_MASK) * 256 + (i_addr & 0xFF)];
+        }
+        if (entry & VALID)
+        {
+            return entry & VALUE_MASK;
+        }
+        return std::nullopt;
+    }
+
+    /**
+     * @brief Gets number of prefixes.
+     */
+    std::size_t size() const
+    {
+        return m_size;
+    }
+
+private:
+    static const std::uint32_t VALID = 1u << 31;            /**< Entry keeps value.        */
+    static const std::uint32_t EXTENDED = 1u << 30;         /**< Entry refers to group.    */
+    static const std::uint32_t VALUE_MASK = EXTENDED - 1;   /**< Value or group index.     */
+
+    /**
+     * @brief Sets entries in range whose prefixes are not longer than given depth.
+     * @param[in] i_begin First entry of tbl8.
+     * @param[in] i_count Number of entries.
+     * @param[in] i_entry New entry.
+     * @param[in] i_depth New depth (prefix length + 1, 0 for no prefix).
+     * @param[in] i_max_depth Only entries with depth up to this are changed.
+     */
+    void fill_tbl8(std::size_t i_begin, std::size_t i_count, std::uint32_t i_entry, std::uint8_t i_depth, std::uint8_t i_max_depth);
+
+    /**
+     * @brief Sets entries of tbl24 and their groups like fill_tbl8.
+     */
+    void fill_tbl24(std::size_t i_begin, std::size_t i_count, std::uint32_t i_entry, std::uint8_t i_depth, std::uint8_t i_max_depth);
+
+    /**
+     * @brief Finds longest stored prefix which covers given prefix and is shorter.
+     * @param[in] i_addr Address of prefix.
+     * @param[in] i_len Length of prefix.
+     * @param[out] o_entry Entry of covering prefix (0 if none).
+     * @param[out] o_depth Depth of covering prefix (0 if none).
+     */
+    void covering(std::uint32_t i_addr, std::uint8_t i_len, std::uint32_t & o_entry, std::uint8_t & o_depth) const;
+
+    std::vector<std::uint32_t> m_tbl24;                                      /**< Entries indexed by first 24 bits. */
+    std::vector<std::uint8_t> m_depth24;                                     /**< Depths of tbl24 entries.          */
+    std::vector<std::uint32_t> m_tbl8;                                       /**< Groups of 256 entries.            */
+    std::vector<std::uint8_t> m_depth8;                                      /**< Depths of tbl8 entries.           */
+    std::vector<std::uint32_t> m_free_groups;                                /**< Released groups.                  */
+    std::vector<std::unordered_map<std::uint32_t, std::uint32_t>> m_rules;   /**< Prefixes by length.               */
+    std::size_t m_size;                                                      /**< Number of prefixes.               */
+};
+
+/**
+ * @brief IPv6 longest prefix match table, multibit trie with stride 8.
+ *
+ * Every node has 256 slots indexed by one byte of address, prefixes are
+ * expanded to slots of node which covers their last bits. Lookup reads one
+ * slot per byte until there is no child and keeps last matching value.
+ */
+class Ipv6LpmTable
+{
+public:
+    /**
+     * @brief Constructs empty table.
+     */
+    Ipv6LpmTable();
+
+    /**
+     * @brief Adds prefix or replaces its value.
+     * @param[in] i_addr Address of prefix.
+     * @param[in] i_len Length of prefix (0..128).
+     * @param[in] i_value Value.
+     * @return True on success.
+     */
+    bool insert(const Ipv6Address & i_addr, std::uint8_t i_len, std::uint32_t i_value);
+
+    /**
+     * @brief Removes prefix.
+     * @param[in] i_addr Address of prefix.
+     * @param[in] i_len Length of prefix (0..128).
+     * @return True if prefix was present.
+     */
+    bool remove(const Ipv6Address & i_addr, std::uint8_t i_len);
+
+    /**
+     * @brief Finds value of longest prefix which contains address.
+     * @param[in] i_addr Address.
+     * @return Value or nothing if no prefix matches.
+     */
+    std::optional<std::uint32_t> lookup(const Ipv6Address & i_addr) const;
+
+    /**
+     * @brief Gets number of prefixes.
+     */
+    std::size_t size() const
+    {
+        return m_size;
+    }
+
+    /**
+     * @brief Gets number of trie nodes.
+     */
+    std::size_t num_nodes() const
+    {
+        return m_slots.size() / 256;
+    }
+
+private:
+    static const std::uint32_t NIL = 0xFFFFFFFFu;   /**< Index of missing node.   */
+
+    /**
+     * @brief Slot of node.
+     */
+    struct Slot
+    {
+        std::uint32_t value;     /**< Value of prefix.                            */
+        std::uint32_t child;     /**< Node of next byte.                          */
+        std::uint8_t depth;      /**< Prefix length + 1, 0 if slot has no value.  */
+    };
+
+    /**
+     * @brief Allocates node with empty slots.
+     * @return Index of node.
+     */
+    std::uint32_t make_node();
+
+    /**
+     * @brief Finds node which keeps prefixes of given length, creates missing nodes.
+     */
+    std::uint32_t find_node(const Ipv6Address & i_addr, std::uint8_t i_len, bool i_create);
+
+    std::vector<Slot> m_slots;                                   /**< Slots of all nodes.       */
+    std::vector<std::map<Ipv6Address, std::uint32_t>> m_rules;   /**< Prefixes by length.       */
+    std::size_t m_size;                                          /**< Number of prefixes.       */
+};
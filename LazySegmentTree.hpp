@@ -0,0 +1,414 @@
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+/**
+ * @brief Aggregated statistics of range: sum, minimum, maximum and length.
+ * @tparam ValueType Type of values.
+ */
+template<class ValueType>
+struct RangeStats
+{
+    ValueType sum;          /**< Sum of values in range.       */
+    ValueType min;          /**< Minimal value in range.       */
+    ValueType max;          /**< Maximal value in range.       */
+    std::size_t len;        /**< Number of values in range.    */
+};
+
+/**
+ * @brief Monoid of range statistics for Lazy Segment Tree.
+ * @tparam ValueType Type of values.
+ */
+template<class ValueType>
+struct StatsMonoid
+{
+    typedef RangeStats<ValueType> value_type;
+
+    /**
+     * @brief Statistics of empty range.
+     */
+    static value_type identity()
+    {
+        value_type res = { ValueType(), std::numeric_limits<ValueType>::max(), std::numeric_limits<ValueType>::lowest(), 0 };
+        return res;
+    }
+
+    /**
+     * @brief Statistics of single value.
+     * @param[in] i_val Input value.
+     */
+    static value_type leaf(const ValueType & i_val)
+    {
+        value_type res = { i_val, i_val, i_val, 1 };
+        return res;
+    }
+
+    /**
+     * @brief Statistics of two adjacent ranges.
+     */
+    static value_type combine(const value_type & i_left, const value_type & i_right)
+    {
+        value_type res = { i_left.sum + i_right.sum,
+                           (i_right.min < i_left.min) ? i_right.min : i_left.min,
+                           (i_left.max < i_right.max) ? i_right.max : i_left.max,
+                           i_left.len + i_right.len };
+        return res;
+    }
+};
+
+/**
+ * @brief Lazy tag which assigns and/or adds value, x -> (assign ? value : x) + add.
+ * @tparam ValueType Type of values.
+ */
+template<class ValueType>
+struct AddAssignTag
+{
+    /**
+     * @brief Definition of tag.
+     */
+    struct tag_type
+    {
+        bool assign;        /**< Indicates assignment.         */
+        ValueType value;    /**< Assigned value.               */
+        ValueType add;      /**< Value added after assignment. */
+    };
+
+    /**
+     * @brief Tag which doesn't change values.
+     */
+    static tag_type identity()
+    {
+        tag_type res = { false, ValueType(), ValueType() };
+        return res;
+    }
+
+    /**
+     * @brief Tag which adds value to range.
+     * @param[in] i_val Value to be added.
+     */
+    static tag_type add(const ValueType & i_val)
+    {
+        tag_type res = { false, ValueType(), i_val };
+        return res;
+    }
+
+    /**
+     * @brief Tag which sets all values of range.
+     * @param[in] i_val New value.
+     */
+    static tag_type assign(const ValueType & i_val)
+    {
+        tag_type res = { true, i_val, ValueType() };
+        return res;
+    }
+
+    /**
+     * @brief Applies tag to statistics of range.
+     */
+    static RangeStats<ValueType> apply(const tag_type & i_tag, const RangeStats<ValueType> & i_stats)
+    {
+        // empty range (padding) stays empty
+        if (i_stats.len == 0)
+        {
+            return i_stats;
+        }
+
+        const ValueType len = static_cast<ValueType>(i_stats.len);
+
+        RangeStats<ValueType> res = i_stats;
+        if (i_tag.assign)
+        {
+            res.sum = i_tag.value * len;
+            res.min = i_tag.value;
+            res.max = i_tag.value;
+        }
+        res.sum += i_tag.add * len;
+        res.min += i_tag.add;
+        res.max += i_tag.add;
+
+        return res;
+    }
+
+    /**
+     * @brief Composes two tags, result is equal to applying older tag and then newer.
+     */
+    static tag_type compose(const tag_type & i_newer, const tag_type & i_older)
+    {
+        // assignment overrides everything before it
+        if (i_newer.assign)
+        {
+            return i_newer;
+        }
+
+        tag_type res = i_older;
+        res.add += i_newer.add;
+        return res;
+    }
+};
+
+/**
+ * @brief Lazy propagation Segment Tree, range update and range query in O(log n).
+ *
+ * Monoid provides value_type, identity() and combine(), Tag provides tag_type,
+ * identity(), apply(tag, value) and compose(newer, older).
+ *
+ * @tparam Monoid Values aggregated by tree.
+ * @tparam Tag Pending updates of tree nodes.
+ */
+template<class Monoid, class Tag>
+class LazySegmentTree
+{
+public:
+    typedef typename Monoid::value_type value_type;
+    typedef typename Tag::tag_type tag_type;
+
+    /**
+     * @brief Update of range left..right.
+     */
+    struct Update
+    {
+        std::size_t left;       /**< Left border.          */
+        std::size_t right;      /**< Right border.         */
+        tag_type tag;           /**< Tag to be applied.    */
+    };
+
+    /**
+     * @brief Constructs tree from given leaves.
+     * @param[in] i_leaves Values of leaves.
+     */
+    LazySegmentTree(const std::vector<value_type> & i_leaves)
+        : m_count(i_leaves.size())
+    {
+        // round up to power of two
+        m_size = 1;
+        m_log = 0;
+        while (m_size < m_count)
+        {
+            m_size *= 2;
+            m_log++;
+        }
+
+        m_tree = std::vector<value_type>(2 * m_size, Monoid::identity());
+        m_lazy = std::vector<tag_type>(m_size, Tag::identity());
+
+        for (std::size_t pos = 0; pos < m_count; ++pos)
+        {
+            m_tree[m_size + pos] = i_leaves[pos];
+        }
+        rebuild();
+    }
+
+    /**
+     * @brief Gets number of elements.
+     */
+    std::size_t size() const
+    {
+        return m_count;
+    }
+
+    /**
+     * @brief Applies tag to all elements in range left..right.
+     * @param[in] i_left Left border.
+     * @param[in] i_right Right border.
+     * @param[in] i_tag Tag to be applied.
+     */
+    void apply(std::size_t i_left, std::size_t i_right, const tag_type & i_tag)
+    {
+        if (i_left > i_right || i_right >= m_count)
+        {
+            return;
+        }
+
+        std::size_t l = i_left + m_size;
+        std::size_t r = i_right + m_size + 1;
+
+        push_borders(l, r);
+        apply_nodes(l, r, i_tag);
+
+        // recalculate ancestors of borders
+        for (std::size_t lvl = 1; lvl <= m_log; ++lvl)
+        {
+            if (((l >> lvl) << lvl) != l)
+            {
+                pull(l >> lvl);
+            }
+            if (((r >> lvl) << lvl) != r)
+            {
+                pull((r - 1) >> lvl);
+            }
+        }
+    }
+
+    /**
+     * @brief Applies many updates in given order.
+     *
+     * Large batches skip recalculation of ancestors after each update and
+     * rebuild whole tree in one sweep at the end.
+     *
+     * @param[in] i_updates Updates to be applied.
+     */
+    void apply_batch(const std::vector<Update> & i_updates)
+    {
+        // small batch, separate updates are cheaper than sweep
+        if (i_updates.size() * m_log < m_size)
+        {
+            for (std::size_t pos = 0; pos < i_updates.size(); ++pos)
+            {
+                apply(i_updates[pos].left, i_updates[pos].right, i_updates[pos].tag);
+            }
+            return;
+        }
+
+        for (std::size_t pos = 0; pos < i_updates.size(); ++pos)
+        {
+            const Update & upd = i_updates[pos];
+            if (upd.left > upd.right || upd.right >= m_count)
+            {
+                continue;
+            }
+
+            const std::size_t l = upd.left + m_size;
+            const std::size_t r = upd.right + m_size + 1;
+
+            // order of tags is kept by pushing borders, values of ancestors become stale
+            push_borders(l, r);
+            apply_nodes(l, r, upd.tag);
+        }
+
+        // move all tags to leaves and recalculate inner nodes
+        for (std::size_t node = 1; node < m_size; ++node)
+        {
+            push(node);
+        }
+        rebuild();
+    }
+
+    /**
+     * @brief Aggregates values in range left..right.
+     * @param[in] i_left Left border.
+     * @param[in] i_right Right border.
+     * @return Aggregated value or identity for invalid range.
+     */
+    value_type query(std::size_t i_left, std::size_t i_right)
+    {
+        if (i_left > i_right || i_right >= m_count)
+        {
+            return Monoid::identity();
+        }
+
+        std::size_t l = i_left + m_size;
+        std::size_t r = i_right + m_size + 1;
+
+        push_borders(l, r);
+
+        // results from left and right borders, keeps order of operands
+        value_type lres = Monoid::identity();
+        value_type rres = Monoid::identity();
+        for (; l < r; l /= 2, r /= 2)
+        {
+            if (l & 1)
+            {
+                lres = Monoid::combine(lres, m_tree[l++]);
+            }
+            if (r & 1)
+            {
+                rres = Monoid::combine(m_tree[--r], rres);
+            }
+        }
+
+        return Monoid::combine(lres, rres);
+    }
+
+private:
+    /**
+     * @brief Recalculates node from its children.
+     */
+    void pull(std::size_t i_node)
+    {
+        m_tree[i_node] = Monoid::combine(m_tree[2 * i_node], m_tree[2 * i_node + 1]);
+    }
+
+    /**
+     * @brief Applies tag to node and stores it for children.
+     */
+    void apply_node(std::size_t i_node, const tag_type & i_tag)
+    {
+        m_tree[i_node] = Tag::apply(i_tag, m_tree[i_node]);
+        if (i_node < m_size)
+        {
+            m_lazy[i_node] = Tag::compose(i_tag, m_lazy[i_node]);
+        }
+    }
+
+    /**
+     * @brief Moves pending tag of node to its children.
+     */
+    void push(std::size_t i_node)
+    {
+        apply_node(2 * i_node, m_lazy[i_node]);
+        apply_node(2 * i_node + 1, m_lazy[i_node]);
+        m_lazy[i_node] = Tag::identity();
+    }
+
+    /**
+     * @brief Pushes tags of all ancestors of half-open range of leaves, top-down.
+     */
+    void push_borders(std::size_t i_left, std::size_t i_right)
+    {
+        for (std::size_t lvl = m_log; lvl >= 1; --lvl)
+        {
+            if (((i_left >> lvl) << lvl) != i_left)
+            {
+                push(i_left >> lvl);
+            }
+            if (((i_right >> lvl) << lvl) != i_right)
+            {
+                push((i_right - 1) >> lvl);
+            }
+        }
+    }
+
+    /**
+     * @brief Applies tag to nodes which cover half-open range of leaves.
+     */
+    void apply_nodes(std::size_t i_left, std::size_t i_right, const tag_type & i_tag)
+    {
+        for (; i_left < i_right; i_left /= 2, i_right /= 2)
+        {
+            if (i_left & 1)
+            {
+                apply_node(i_left++, i_tag);
+            }
+            if (i_right & 1)
+            {
+                apply_node(--i_right, i_tag);
+            }
+        }
+    }
+
+    /**
+     * @brief Recalculates all inner nodes from leaves.
+     */
+    void rebuild()
+    {
+        for (std::size_t node = m_size - 1; node > 0; --node)
+        {
+            pull(node);
+        }
+    }
+
+    std::vector<value_type> m_tree;   /**< Aggregated values of nodes.      */
+    std::vector<tag_type> m_lazy;     /**< Pending tags of inner nodes.     */
+    std::size_t m_count;              /**< Number of elements.              */
+    std::size_t m_size;               /**< Number of leaves.                */
+    std::size_t m_log;                /**< Height of tree.                  */
+};
+
+/**
+ * @brief Lazy Segment Tree with range add, range assignment and range sum/min/max.
+ * @tparam ValueType Type of values.
+ */
+template<class ValueType>
+using RangeStatsTree = LazySegmentTree<StatsMonoid<ValueType>, AddAssignTag<ValueType>>;
@@ -0,0 +1,287 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <utility>
+#include <algorithm>
+
+#include "LoudsTrie.hpp"
+
+namespace
+{
+    /**
+     * @brief Signature of serialized trie.
+     */
+    const std::uint32_t MAGIC = 0x31544F4C; // "LOT1"
+
+    /**
+     * @brief Header of serialized trie.
+     */
+    struct Header
+    {
+        std::uint32_t magic;        /**< Signature.         */
+        std::uint32_t reserved;     /**< Padding.           */
+        std::uint64_t num_nodes;    /**< Number of nodes.   */
+    };
+
+    /**
+     * @brief Appends bit to packed bits.
+     */
+    void push_bit(std::vector<std::uint64_t> & io_words, std::size_t & io_size, bool i_bit)
+    {
+        if (io_size % 64 == 0)
+        {
+            io_words.push_back(0);
+        }
+        if (i_bit)
+        {
+            io_words.back() |= std::uint64_t(1) << (io_size % 64);
+        }
+        io_size++;
+    }
+}
+
+/**
+* @brief Constructs empty trie.
+*/
+LoudsTrie::LoudsTrie()
+    : m_labels(nullptr)
+    , m_num_nodes(0)
+{}
+
+/**
+* @brief Builds trie from set of keys.
+* @param[in] i_keys Keys, value of key is its index in level order of trie.
+*/
+LoudsTrie::LoudsTrie(const std::vector<std::string> & i_keys)
+    : m_labels(nullptr)
+    , m_num_nodes(0)
+{
+    std::vector<std::string> keys = i_keys;
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+    std::vector<std::uint64_t> louds;
+    std::vector<std::uint64_t> terminal;
+    std::size_t louds_size = 0;
+    std::size_t terminal_size = 0;
+
+    // ranges of keys which share prefix of current node, level by level
+    std::vector<std::pair<std::size_t, std::size_t>> level(1, std::make_pair(std::size_t(0), keys.size()));
+    std::vector<std::pair<std::size_t, std::size_t>> next;
+
+    for (std::size_t depth = 0; !level.empty(); ++depth)
+    {
+        next.clear();
+        for (std::size_t idx = 0; idx < level.size(); ++idx)
+        {
+            std::size_t begin = level[idx].first;
+            const std::size_t end = level[idx].second;
+
+            // shortest key goes first in sorted range
+            const bool is_key = begin < end && keys[begin].size() == depth;
+            push_bit(terminal, terminal_size, is_key);
+            if (is_key)
+            {
+                begin++;
+            }
+
+            // group keys by next byte
+            while (begin < end)
+            {
+                const char chr = keys[begin][depth];
+                std::size_t last = begin + 1;
+                while (last < end && keys[last][depth] == chr)
+                {
+                    last++;
+                }
+
+                m_labels_data.push_back(static_cast<unsigned char>(chr));
+                push_bit(louds, louds_size, true);
+                next.push_back(std::make_pair(begin, last));
+                begin = last;
+            }
+            push_bit(louds, louds_size, false);
+            m_num_nodes++;
+        }
+        level.swap(next);
+    }
+
+    m_louds = SuccinctBitVector(louds, louds_size);
+    m_terminal = SuccinctBitVector(terminal, terminal_size);
+    m_labels = m_labels_data.data();
+}
+
+/**
+* @brief Creates trie which uses serialized buffer in place (e.g. mmapped file).
+* @param[in] i_data Buffer created by serialize(), aligned to 8 bytes.
+* @param[in] i_bytes Size of buffer.
+* @return Trie which refers to buffer, empty trie if buffer is invalid.
+* @note Sizes and directories are checked, bits are not read. Corrupted bits
+*       give wrong answers, but queries stay inside of buffer.
+*/
+LoudsTrie LoudsTrie::view(const void * i_data, std::size_t i_bytes)
+{
+    LoudsTrie res;
+
+    if (i_data == nullptr || i_bytes < sizeof(Header))
+    {
+        return res;
+    }
+
+    Header header;
+    std::memcpy(&header, i_data, sizeof(Header));
+    if (header.magic != MAGIC || header.num_nodes == 0)
+    {
+        return res;
+    }
+
+    const char * data = static_cast<const char *>(i_data);
+    std::size_t offset = sizeof(Header);
+
+    // both bit vectors follow header
+    const std::size_t louds_bytes = SuccinctBitVector::view(data + offset, i_bytes - offset, res.m_louds);
+    offset += louds_bytes;
+    const std::size_t terminal_bytes = (louds_bytes == 0) ? 0 : SuccinctBitVector::view(data + offset, i_bytes - offset, res.m_terminal);
+    offset += terminal_bytes;
+
+    // labels of all nodes except root, LOUDS has zero for every node and one for every edge
+    if (terminal_bytes == 0 || i_bytes - offset < header.num_nodes - 1 || res.m_terminal.size() != header.num_nodes ||
+        res.m_louds.size() != 2 * res.m_terminal.size() - 1 || res.m_louds.ones() != header.num_nodes - 1)
+    {
+        return LoudsTrie();
+    }
+
+    res.m_labels = reinterpret_cast<const unsigned char *>(data + offset);
+    res.m_num_nodes = header.num_nodes;
+
+    return res;
+}
+
+/**
+* @brief Follows edge from node by byte.
+* @return Next node or 0 (root is never a child).
+*/
+std::size_t LoudsTrie::child(std::size_t i_node, unsigned char i_byte) const
+{
+    // bits of node are between its predecessor's zero and its own zero
+    const std::size_t begin = (i_node == 0) ? 0 : m_louds.select0(i_node - 1) + 1;
+    const std::size_t end = m_louds.select0(i_node);
+    if (begin >= end || begin < i_node || end - i_node > m_num_nodes - 1)
+    {
+        return 0;
+    }
+
+    // labels of children are sorted, number of ones before begin is begin - node
+    const unsigned char * first = m_labels + (begin - i_node);
+    const unsigned char * last = first + (end - begin);
+    const unsigned char * pos = std::lower_bound(first, last, i_byte);
+    if (pos == last || *pos != i_byte)
+    {
+        return 0;
+    }
+
+    return (pos - m_labels) + 1;
+}
+
+/**
+* @brief Searches key in trie.
+* @param[in] i_key Key to be searched.
+* @return Value of key or -1 if key is not present.
+*/
+int LoudsTrie::exact_match(const std::string & i_key) const
+{
+    if (m_num_nodes == 0)
+    {
+        return -1;
+    }
+
+    std::size_t node = 0;
+    for (std::size_t level = 0; level < i_key.size(); ++level)
+    {
+        node = child(node, static_cast<unsigned char>(i_key[level]));
+        if (node == 0)
+        {
+            return -1;
+        }
+    }
+
+    // value is number of keys before node in level order
+    return m_terminal.get(node) ? static_cast<int>(m_terminal.rank1(node)) : -1;
+}
+
+/**
+* @brief Finds longest prefix of input string which is in trie keys.
+* @param[in] i_key Key to be searched.
+* @return Key from trie which is longest prefix of input key.
+*/
+std::string LoudsTrie::longest_prefix(const std::string & i_key) const
+{
+    if (m_num_nodes == 0)
+    {
+        return std::string();
+    }
+
+    std::size_t len = 0;
+    std::size_t node = 0;
+    for (std::size_t level = 0; ; ++level)
+    {
+        // store previous matching prefix
+        if (m_terminal.get(node))
+        {
+            len = level;
+        }
+
+        if (level == i_key.size())
+        {
+            break;
+        }
+
+        node = child(node, static_cast<unsigned char>(i_key[level]));
+        if (node == 0)
+        {
+            break;
+        }
+    }
+
+    return i_key.substr(0, len);
+}
+
+/**
+* @brief Serializes trie into flat buffer.
+* @return Header followed by LOUDS bits, terminal bits and labels.
+*/
+std::vector<char> LoudsTrie::serialize() const
+{
+    const Header header = { MAGIC, 0, m_num_nodes };
+
+    std::vector<char> res(sizeof(Header));
+    std::memcpy(res.data(), &header, sizeof(Header));
+    if (m_num_nodes == 0)
+    {
+        return res;
+    }
+
+    m_louds.serialize(res);
+    m_terminal.serialize(res);
+    res.insert(res.end(), m_labels, m_labels + (m_num_nodes - 1));
+
+    return res;
+}
+
+/**
+* @brief Writes serialized trie to file.
+* @param[in] i_path Path to file.
+* @return True on success.
+*/
+bool LoudsTrie::save(const std::string & i_path) const
+{
+    const std::vector<char> buffer = serialize();
+
+    std::ofstream out(i_path.c_str(), std::ios::binary);
+    out.write(buffer.data(), buffer.size());
+
+    return static_cast<bool>(out);
+}
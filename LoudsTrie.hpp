@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "SuccinctBitVector.hpp"
+
+/**
+ * @brief Static succinct trie in LOUDS (level-order unary degree sequence) encoding.
+ *
+ * Nodes are numbered in level order, node x with d children is written as
+ * d ones followed by zero. Children of node x are bits select0(x-1)+1..select0(x)-1
+ * and first of them has number select0(x-1) - x + 2. Labels of edges are kept in
+ * level order and a separate bit vector marks nodes where keys end, so each node
+ * costs about 11 bits plus rank/select directory. Trie can be serialized into
+ * flat buffer and queried in place (e.g. from mmapped file).
+ */
+class LoudsTrie
+{
+public:
+    /**
+     * @brief Builds trie from set of keys.
+     * @param[in] i_keys Keys, value of key is its index in level order of trie.
+     */
+    LoudsTrie(const std::vector<std::string> & i_keys);
+
+    LoudsTrie(const LoudsTrie &) = delete;
+    LoudsTrie & operator=(const LoudsTrie &) = delete;
+    LoudsTrie(LoudsTrie &&) = default;
+    LoudsTrie & operator=(LoudsTrie &&) = default;
+
+    /**
+     * @brief Creates trie which uses serialized buffer in place (e.g. mmapped file).
+     * @param[in] i_data Buffer created by serialize(), aligned to 8 bytes.
+     * @param[in] i_bytes Size of buffer.
+     * @return Trie which refers to buffer, empty trie if buffer is invalid.
+     * @note Sizes and directories are checked, bits are not read. Corrupted bits
+     *       give wrong answers, but queries stay inside of buffer.
+     */
+    static LoudsTrie view(const void * i_data, std::size_t i_bytes);
+
+    /**
+     * @brief Gets number of keys.
+     */
+    std::size_t size() const
+    {
+        return m_terminal.ones();
+    }
+
+    /**
+     * @brief Gets number of nodes.
+     */
+    std::size_t num_nodes() const
+    {
+        return m_num_nodes;
+    }
+
+    /**
+     * @brief Searches key in trie.
+     * @param[in] i_key Key to be searched.
+     * @return Value of key or -1 if key is not present.
+     */
+    int exact_match(const std::string & i_key) const;
+
+    /**
+     * @brief Searches key in trie.
+     * @param[in] i_key Key to be searched.
+     * @return True if key is present in trie or False otherwise.
+     */
+    bool search(const std::string & i_key) const
+    {
+        return exact_match(i_key) >= 0;
+    }
+
+    /**
+     * @brief Finds longest prefix of input string which is in trie keys.
+     * @param[in] i_key Key to be searched.
+     * @return Key from trie which is longest prefix of input key.
+     */
+    std::string longest_prefix(const std::string & i_key) const;
+
+    /**
+     * @brief Serializes trie into flat buffer.
+     * @return Header followed by LOUDS bits, terminal bits and labels.
+     */
+    std::vector<char> serialize() const;
+
+    /**
+     * @brief Writes serialized trie to file.
+     * @param[in] i_path Path to file.
+     * @return True on success.
+     */
+    bool save(const std::string & i_path) const;
+
+private:
+    /**
+     * @brief Constructs empty trie.
+     */
+    LoudsTrie();
+
+    /**
+     * @brief Follows edge from node by byte.
+     * @return Next node or 0 (root is never a child).
+     */
+    std::size_t child(std::size_t i_node, unsigned char i_byte) const;
+
+    SuccinctBitVector m_louds;                    /**< Degrees of nodes in level order.    */
+    SuccinctBitVector m_terminal;                 /**< Nodes where keys end.               */
+    std::vector<unsigned char> m_labels_data;     /**< Own labels of edges.                */
+    const unsigned char * m_labels;               /**< Labels of edges (own or external).  */
+    std::size_t m_num_nodes;                      /**< Number of nodes.                    */
+};
@@ -0,0 +1,233 @@
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "PersistentRangeSumQuery.hpp"
+
+namespace
+{
+    /**
+     * @brief Index of missing node.
+     */
+    const std::uint32_t NIL = UINT32_MAX;
+
+    /**
+     * @brief Find middle point.
+     */
+    int mid(int i_left, int i_right)
+    {
+        return i_left + (i_right - i_left) / 2;
+    }
+}
+
+/**
+* @brief Allocates node from arena and links its children.
+*/
+std::uint32_t PersistentRangeSumQuery::make_node(std::uint32_t i_left, std::uint32_t i_right, int i_sum)
+{
+    Node node = { i_left, i_right, 0, i_sum };
+
+    // new parent for children
+    if (i_left != NIL)
+    {
+        m_nodes[i_left].refs++;
+    }
+    if (i_right != NIL)
+    {
+        m_nodes[i_right].refs++;
+    }
+
+    // reuse released node
+    if (!m_free.empty())
+    {
+        const std::uint32_t idx = m_free.back();
+        m_free.pop_back();
+        m_nodes[idx] = node;
+        return idx;
+    }
+
+    m_nodes.push_back(node);
+    return static_cast<std::uint32_t>(m_nodes.size() - 1);
+}
+
+/**
+* @brief Helper function for Segment tree construction.
+*/
+std::uint32_t PersistentRangeSumQuery::construct_util(const std::vector<int> & i_arr, int i_left, int i_right)
+{
+    if (i_left == i_right)
+    {
+        return make_node(NIL, NIL, i_arr[i_left]);
+    }
+
+    // find middle index
+    int m = mid(i_left, i_right);
+
+    const std::uint32_t l = construct_util(i_arr, i_left, m);
+    const std::uint32_t r = construct_util(i_arr, m + 1, i_right);
+
+    return make_node(l, r, m_nodes[l].sum + m_nodes[r].sum);
+}
+
+/**
+* @brief Helper function, copies path to updated leaf.
+*/
+std::uint32_t PersistentRangeSumQuery::update_util(std::uint32_t i_node, int i_left, int i_right, int i_pos, int i_new_val)
+{
+    if (i_left == i_right)
+    {
+        return make_node(NIL, NIL, i_new_val);
+    }
+
+    // get mid point
+    int m = mid(i_left, i_right);
+
+    // copy child which contains position, share other child
+    std::uint32_t l = m_nodes[i_node].left;
+    std::uint32_t r = m_nodes[i_node].right;
+    if (i_pos <= m)
+    {
+        l = update_util(l, i_left, m, i_pos, i_new_val);
+    }
+    else
+    {
+        r = update_util(r, m + 1, i_right, i_pos, i_new_val);
+    }
+
+    return make_node(l, r, m_nodes[l].sum + m_nodes[r].sum);
+}
+
+/**
+* @brief Helper function, calculates sum of range.
+*/
+int PersistentRangeSumQuery::get_sum_util(std::uint32_t i_node, int i_rleft, int i_rright, int i_left, int i_right) const
+{
+    // check if segment of node is part of given range
+    if (i_left <= i_rleft && i_rright <= i_right)
+    {
+        return m_nodes[i_node].sum;
+    }
+
+    // segment don't overlap
+    if (i_rright < i_left || i_rleft > i_right)
+    {
+        return 0;
+    }
+
+    // get mid point
+    int rm = mid(i_rleft, i_rright);
+
+    return get_sum_util(m_nodes[i_node].left, i_rleft, rm, i_left, i_right) +
+        get_sum_util(m_nodes[i_node].right, rm + 1, i_rright, i_left, i_right);
+}
+
+/**
+* @brief Constructs segment tree from given array, it becomes version 0.
+* @param[in] i_arr Input array.
+*/
+void PersistentRangeSumQuery::construct(const std::vector<int> & i_arr)
+{
+    m_nodes.clear();
+    m_free.clear();
+    m_roots.clear();
+
+    m_size = i_arr.size();
+    if (m_size == 0)
+    {
+        m_roots.push_back(NIL);
+        return;
+    }
+
+    // full tree has 2n - 1 nodes
+    m_nodes.reserve(2 * m_size - 1);
+
+    const std::uint32_t root = construct_util(i_arr, 0, m_size - 1);
+    m_nodes[root].refs++;
+    m_roots.push_back(root);
+}
+
+/**
+* @brief Creates new version with updated value at given position.
+* @param[in] i_version Base version.
+* @param[in] i_pos Position in array.
+* @param[in] i_new_val New value.
+* @return Id of new version or base version if arguments are invalid.
+*/
+std::size_t PersistentRangeSumQuery::update(std::size_t i_version, int i_pos, int i_new_val)
+{
+    // check version and index range
+    if (!is_alive(i_version) || i_pos < 0 || i_pos > static_cast<int>(m_size) - 1)
+    {
+        return i_version;
+    }
+
+    const std::uint32_t root = update_util(m_roots[i_version], 0, m_size - 1, i_pos, i_new_val);
+    m_nodes[root].refs++;
+    m_roots.push_back(root);
+
+    return m_roots.size() - 1;
+}
+
+/**
+* @brief Calculates sum of values in given range of given version.
+* @param[in] i_version Version of array.
+* @param[in] i_left Left border.
+* @param[in] i_right Right border.
+* @return Sum of given range or -1 for invalid arguments.
+*/
+int PersistentRangeSumQuery::get_sum(std::size_t i_version, int i_left, int i_right) const
+{
+    if (!is_alive(i_version) || i_left < 0 || i_right > static_cast<int>(m_size) - 1 || i_left > i_right)
+    {
+        return -1;
+    }
+
+    return get_sum_util(m_roots[i_version], 0, m_size - 1, i_left, i_right);
+}
+
+/**
+* @brief Releases version, its nodes are reused by following updates.
+* @param[in] i_version Version to be released.
+*/
+void PersistentRangeSumQuery::release(std::size_t i_version)
+{
+    if (!is_alive(i_version))
+    {
+        return;
+    }
+
+    // nodes whose reference should be dropped
+    std::vector<std::uint32_t> stack(1, m_roots[i_version]);
+    m_roots[i_version] = NIL;
+
+    while (!stack.empty())
+    {
+        const std::uint32_t idx = stack.back();
+        stack.pop_back();
+
+        // node is still shared
+        if (--m_nodes[idx].refs > 0)
+        {
+            continue;
+        }
+
+        if (m_nodes[idx].left != NIL)
+        {
+            stack.push_back(m_nodes[idx].left);
+        }
+        if (m_nodes[idx].right != NIL)
+        {
+            stack.push_back(m_nodes[idx].right);
+        }
+        m_free.push_back(idx);
+    }
+}
+
+/**
+* @brief Checks wether version exists and was not released.
+* @param[in] i_version Version of array.
+*/
+bool PersistentRangeSumQuery::is_alive(std::size_t i_version) const
+{
+    return i_version < m_roots.size() && m_roots[i_version] != NIL;
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Persistent (versioned) segment tree for range sum queries.
+ *
+ * Every update copies path from root to leaf, so it creates O(log n) new nodes
+ * and leaves all previous versions untouched. Nodes live in arena and are
+ * reference counted, released versions return their unique nodes to free list.
+ */
+class PersistentRangeSumQuery
+{
+public:
+    /**
+     * @brief Constructs segment tree from given array, it becomes version 0.
+     * @param[in] i_arr Input array.
+     */
+    void construct(const std::vector<int> & i_arr);
+
+    /**
+     * @brief Creates new version with updated value at given position.
+     * @param[in] i_version Base version.
+     * @param[in] i_pos Position in array.
+     * @param[in] i_new_val New value.
+     * @return Id of new version or base version if arguments are invalid.
+     */
+    std::size_t update(std::size_t i_version, int i_pos, int i_new_val);
+
+    /**
+     * @brief Calculates sum of values in given range of given version.
+     * @param[in] i_version Version of array.
+     * @param[in] i_left Left border.
+     * @param[in] i_right Right border.
+     * @return Sum of given range or -1 for invalid arguments.
+     */
+    int get_sum(std::size_t i_version, int i_left, int i_right) const;
+
+    /**
+     * @brief Releases version, its nodes are reused by following updates.
+     * @param[in] i_version Version to be released.
+     */
+    void release(std::size_t i_version);
+
+    /**
+     * @brief Checks wether version exists and was not released.
+     * @param[in] i_version Version of array.
+     */
+    bool is_alive(std::size_t i_version) const;
+
+    /**
+     * @brief Gets number of created versions (including released).
+     */
+    std::size_t num_versions() const
+    {
+        return m_roots.size();
+    }
+
+    /**
+     * @brief Gets number of nodes used by retained versions.
+     */
+    std::size_t num_nodes() const
+    {
+        return m_nodes.size() - m_free.size();
+    }
+
+private:
+    /**
+     * @brief Definition of tree node.
+     */
+    struct Node
+    {
+        std::uint32_t left;     /**< Index of left child.                 */
+        std::uint32_t right;    /**< Index of right child.                */
+        std::uint32_t refs;     /**< Number of parents and versions.      */
+        int sum;                /**< Sum of segment.                      */
+    };
+
+    /**
+     * @brief Allocates node from arena and links its children.
+     */
+    std::uint32_t make_node(std::uint32_t i_left, std::uint32_t i_right, int i_sum);
+
+    /**
+     * @brief Helper function for Segment tree construction.
+     */
+    std::uint32_t construct_util(const std::vector<int> & i_arr, int i_left, int i_right);
+
+    /**
+     * @brief Helper function, copies path to updated leaf.
+     */
+    std::uint32_t update_util(std::uint32_t i_node, int i_left, int i_right, int i_pos, int i_new_val);
+
+    /**
+     * @brief Helper function, calculates sum of range.
+     */
+    int get_sum_util(std::uint32_t i_node, int i_rleft, int i_rright, int i_left, int i_right) const;
+
+    std::vector<Node> m_nodes;            /**< Arena of nodes.                    */
+    std::vector<std::uint32_t> m_free;    /**< Free nodes in arena.               */
+    std::vector<std::uint32_t> m_roots;   /**< Root of each version.              */
+    std::size_t m_size;                   /**< Number of elements in array.       */
+};
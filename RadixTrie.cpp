@@ -0,0 +1,657 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "RadixTrie.hpp"
+
+const std::size_t RadixTrie::PREFIX_INLINE;
+
+namespace
+{
+    typedef RadixTrie::Node Node;
+
+#ifdef __SSE2__
+    /**
+     * @brief Index of lowest set bit.
+     */
+    int lowest_bit(std::uint32_t i_mask)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_ctz(i_mask);
+#else
+        int res = 0;
+        while ((i_mask & 1) == 0)
+        {
+            i_mask >>= 1;
+            res++;
+        }
+        return res;
+#endif
+    }
+#endif
+
+    /**
+     * @brief Finds slot of child for given byte.
+     * @param[in] i_node Trie node.
+     * @param[in] i_byte Byte of child.
+     * @return Pointer to slot with child or nullptr.
+     */
+    Node ** find_child_ref(Node * i_node, std::uint8_t i_byte)
+    {
+        switch (i_node->type)
+        {
+        case RadixTrie::NODE4:
+        {
+            RadixTrie::Node4 * node = static_cast<RadixTrie::Node4 *>(i_node);
+            for (std::size_t pos = 0; pos < node->count; ++pos)
+            {
+                if (node->keys[pos] == i_byte)
+                {
+                    return &node->children[pos];
+                }
+            }
+            return nullptr;
+        }
+        case RadixTrie::NODE16:
+        {
+            RadixTrie::Node16 * node = static_cast<RadixTrie::Node16 *>(i_node);
+#ifdef __SSE2__
+            // compare all 16 keys at once
+            const __m128i cmp = _mm_cmpeq_epi8(_mm_set1_epi8(static_cast<char>(i_byte)),
+                _mm_loadu_si128(reinterpret_cast<const __m128i *>(node->keys)));
+            const unsigned mask = _mm_movemask_epi8(cmp) & ((1u << node->count) - 1);
+            if (mask != 0)
+            {
+                return &node->children[lowest_bit(mask)];
+            }
+#else
+            for (std::size_t pos = 0; pos < node->count; ++pos)
+            {
+                if (node->keys[pos] == i_byte)
+                {
+                    return &node->children[pos];
+                }
+            }
+#endif
+            return nullptr;
+        }
+        case RadixTrie::NODE48:
+        {
+            RadixTrie::Node48 * node = static_cast<RadixTrie::Node48 *>(i_node);
+            const std::uint8_t slot = node->index[i_byte];
+            return (slot != 0) ? &node->children[slot - 1] : nullptr;
+        }
+        default:
+        {
+            RadixTrie::Node256 * node = static_cast<RadixTrie::Node256 *>(i_node);
+            return (node->children[i_byte] != nullptr) ? &node->children[i_byte] : nullptr;
+        }
+        }
+    }
+
+    /**
+     * @brief Finds child for given byte.
+     */
+    const Node * find_child(const Node * i_node, std::uint8_t i_byte)
+    {
+        Node ** ref = find_child_ref(const_cast<Node *>(i_node), i_byte);
+        return (ref != nullptr) ? *ref : nullptr;
+    }
+
+    /**
+     * @brief Collects all children of node ordered by byte.
+     * @param[in] i_node Trie node.
+     * @param[out] o_bytes Bytes of children.
+     * @param[out] o_children Children.
+     */
+    void collect_children(Node * i_node, std::vector<std::uint8_t> & o_bytes, std::vector<Node *> & o_children)
+    {
+        for (unsigned byte = 0; byte < 256; ++byte)
+        {
+            Node ** ref = find_child_ref(i_node, static_cast<std::uint8_t>(byte));
+            if (ref != nullptr)
+            {
+                o_bytes.push_back(static_cast<std::uint8_t>(byte));
+                o_children.push_back(*ref);
+            }
+        }
+    }
+
+    /**
+     * @brief Maximal number of children of node type.
+     */
+    std::size_t capacity(std::uint8_t i_type)
+    {
+        switch (i_type)
+        {
+        case RadixTrie::NODE4:
+            return 4;
+        case RadixTrie::NODE16:
+            return 16;
+        case RadixTrie::NODE48:
+            return 48;
+        default:
+            return 256;
+        }
+    }
+
+    /**
+     * @brief Gets bytes of compressed path of node.
+     */
+    const char * prefix_data(const Node * i_node)
+    {
+        return (i_node->length > RadixTrie::PREFIX_INLINE) ? i_node->prefix.data : i_node->prefix.bytes;
+    }
+
+    /**
+     * @brief Replaces compressed path of node.
+     * @param[in,out] io_node Trie node.
+     * @param[in] i_data Bytes of new path, may point into current path.
+     * @param[in] i_len Length of new path.
+     */
+    void set_prefix(Node * io_node, const char * i_data, std::size_t i_len)
+    {
+        // old array is released after copy
+        char * old = (io_node->length > RadixTrie::PREFIX_INLINE) ? io_node->prefix.data : nullptr;
+        if (i_len > RadixTrie::PREFIX_INLINE)
+        {
+            char * data = new char[i_len];
+            std::memcpy(data, i_data, i_len);
+            io_node->prefix.data = data;
+        }
+        else if (i_len > 0)
+        {
+            std::memmove(io_node->prefix.bytes, i_data, i_len);
+        }
+        io_node->length = static_cast<std::uint32_t>(i_len);
+        delete[] old;
+    }
+
+    /**
+     * @brief Checks that whole compressed path of node matches key starting at depth.
+     */
+    bool match_prefix(const Node * i_node, const std::string & i_key, std::size_t i_depth)
+    {
+        return i_key.size() - i_depth >= i_node->length &&
+               std::memcmp(i_key.data() + i_depth, prefix_data(i_node), i_node->length) == 0;
+    }
+
+    /**
+     * @brief Length of common prefix of node path and key starting at depth.
+     */
+    std::size_t common_prefix(const Node * i_node, const std::string & i_key, std::size_t i_depth)
+    {
+        const char * prefix = prefix_data(i_node);
+        std::size_t len = 0;
+        while (len < i_node->length && i_depth + len < i_key.size() && prefix[len] == i_key[i_depth + len])
+        {
+            len++;
+        }
+        return len;
+    }
+}
+
+/**
+* @brief Default constructor.
+*/
+RadixTrie::RadixTrie()
+    : m_root(nullptr)
+    , m_count(0)
+    , m_keys(0)
+    , m_nodes(0)
+{
+    m_root = make_node(NODE4);
+}
+
+/**
+* @brief Destructor.
+*/
+RadixTrie::~RadixTrie()
+{
+    free_tree(m_root);
+}
+
+/**
+* @brief Allocates empty node of given type.
+*/
+RadixTrie::Node * RadixTrie::make_node(NodeType i_type)
+{
+    Node * node = nullptr;
+    switch (i_type)
+    {
+    case NODE4:
+        node = new Node4();
+        break;
+    case NODE16:
+        node = new Node16();
+        break;
+    case NODE48:
+        node = new Node48();
+        break;
+    default:
+        node = new Node256();
+        break;
+    }
+
+    node->value = 0;
+    node->is_key = false;
+    node->type = static_cast<std::uint8_t>(i_type);
+    node->count = 0;
+    m_nodes++;
+
+    return node;
+}
+
+/**
+* @brief Releases node (without children).
+*/
+void RadixTrie::free_node(Node * i_node)
+{
+    set_prefix(i_node, nullptr, 0);
+
+    switch (i_node->type)
+    {
+    case NODE4:
+        delete static_cast<Node4 *>(i_node);
+        break;
+    case NODE16:
+        delete static_cast<Node16 *>(i_node);
+        break;
+    case NODE48:
+        delete static_cast<Node48 *>(i_node);
+        break;
+    default:
+        delete static_cast<Node256 *>(i_node);
+        break;
+    }
+    m_nodes--;
+}
+
+/**
+* @brief Releases node and all its descendants.
+*/
+void RadixTrie::free_tree(Node * i_node)
+{
+    std::vector<Node *> stack(1, i_node);
+    while (!stack.empty())
+    {
+        Node * node = stack.back();
+        stack.pop_back();
+
+        std::vector<std::uint8_t> bytes;
+        collect_children(node, bytes, stack);
+        free_node(node);
+    }
+}
+
+/**
+* @brief Replaces node by node of other type with the same content.
+* @param[in,out] io_ref Reference to node in parent.
+* @param[in] i_type New type.
+*/
+void RadixTrie::change_type(Node ** io_ref, NodeType i_type)
+{
+    Node * old = *io_ref;
+
+    std::vector<std::uint8_t> bytes;
+    std::vector<Node *> children;
+    collect_children(old, bytes, children);
+
+    Node * node = make_node(i_type);
+    // path moves to new node
+    node->prefix = old->prefix;
+    node->length = old->length;
+    old->length = 0;
+    node->value = old->value;
+    node->is_key = old->is_key;
+
+    *io_ref = node;
+    free_node(old);
+
+    for (std::size_t pos = 0; pos < children.size(); ++pos)
+    {
+        add_child(io_ref, bytes[pos], children[pos]);
+    }
+}
+
+/**
+* @brief Adds child, grows node if it is full.
+* @param[in,out] io_ref Reference to node in parent.
+* @param[in] i_byte Byte of child.
+* @param[in] i_child Child to be added.
+*/
+void RadixTrie::add_child(Node ** io_ref, std::uint8_t i_byte, Node * i_child)
+{
+    if ((*io_ref)->count == capacity((*io_ref)->type))
+    {
+        change_type(io_ref, static_cast<NodeType>((*io_ref)->type + 1));
+    }
+
+    Node * node = *io_ref;
+    switch (node->type)
+    {
+    case NODE4:
+    case NODE16:
+    {
+        // both keep sorted keys followed by children
+        std::uint8_t * keys = (node->type == NODE4) ? static_cast<Node4 *>(node)->keys : static_cast<Node16 *>(node)->keys;
+        Node ** children = (node->type == NODE4) ? static_cast<Node4 *>(node)->children : static_cast<Node16 *>(node)->children;
+
+        std::size_t pos = node->count;
+        while (pos > 0 && keys[pos - 1] > i_byte)
+        {
+            keys[pos] = keys[pos - 1];
+            children[pos] = children[pos - 1];
+            pos--;
+        }
+        keys[pos] = i_byte;
+        children[pos] = i_child;
+        break;
+    }
+    case NODE48:
+    {
+        Node48 * n48 = static_cast<Node48 *>(node);
+        // first free slot
+        std::size_t slot = 0;
+        while (n48->children[slot] != nullptr)
+        {
+            slot++;
+        }
+        n48->children[slot] = i_child;
+        n48->index[i_byte] = static_cast<std::uint8_t>(slot + 1);
+        break;
+    }
+    default:
+        static_cast<Node256 *>(node)->children[i_byte] = i_child;
+        break;
+    }
+
+    node->count++;
+}
+
+/**
+* @brief Removes child, shrinks node if it is sparse.
+* @param[in,out] io_ref Reference to node in parent.
+* @param[in] i_byte Byte of child.
+*/
+void RadixTrie::remove_child(Node ** io_ref, std::uint8_t i_byte)
+{
+    Node * node = *io_ref;
+    switch (node->type)
+    {
+    case NODE4:
+    case NODE16:
+    {
+        std::uint8_t * keys = (node->type == NODE4) ? static_cast<Node4 *>(node)->keys : static_cast<Node16 *>(node)->keys;
+        Node ** children = (node->type == NODE4) ? static_cast<Node4 *>(node)->children : static_cast<Node16 *>(node)->children;
+
+        std::size_t pos = 0;
+        while (keys[pos] != i_byte)
+        {
+            pos++;
+        }
+        for (; pos + 1 < node->count; ++pos)
+        {
+            keys[pos] = keys[pos + 1];
+            children[pos] = children[pos + 1];
+        }
+        break;
+    }
+    case NODE48:
+    {
+        Node48 * n48 = static_cast<Node48 *>(node);
+        n48->children[n48->index[i_byte] - 1] = nullptr;
+        n48->index[i_byte] = 0;
+        break;
+    }
+    default:
+        static_cast<Node256 *>(node)->children[i_byte] = nullptr;
+        break;
+    }
+
+    node->count--;
+
+    // shrink with hysteresis to avoid flapping between types
+    if ((node->type == NODE16 && node->count <= 3) ||
+        (node->type == NODE48 && node->count <= 12) ||
+        (node->type == NODE256 && node->count <= 40))
+    {
+        change_type(io_ref, static_cast<NodeType>(node->type - 1));
+    }
+}
+
+/**
+* @brief Adds new key to trie.
+* @param[in] i_key Key to be added.
+*/
+void RadixTrie::insert(const std::string & i_key)
+{
+    // increase number of insertions
+    m_count++;
+
+    Node ** ref = &m_root;
+    std::size_t depth = 0;
+
+    for (;;)
+    {
+        Node * node = *ref;
+        const std::size_t match = common_prefix(node, i_key, depth);
+
+        // key diverges inside compressed path, split it
+        if (match < node->length)
+        {
+            Node * parent = make_node(NODE4);
+            set_prefix(parent, prefix_data(node), match);
+
+            const std::uint8_t byte = static_cast<std::uint8_t>(prefix_data(node)[match]);
+            set_prefix(node, prefix_data(node) + match + 1, node->length - match - 1);
+            *ref = parent;
+            add_child(ref, byte, node);
+
+            if (depth + match == i_key.size())
+            {
+                // key ends at split point
+                (*ref)->is_key = true;
+                (*ref)->value = static_cast<int>(m_count);
+            }
+            else
+            {
+                Node * leaf = make_node(NODE4);
+                set_prefix(leaf, i_key.data() + depth + match + 1, i_key.size() - depth - match - 1);
+                leaf->is_key = true;
+                leaf->value = static_cast<int>(m_count);
+                add_child(ref, static_cast<std::uint8_t>(i_key[depth + match]), leaf);
+            }
+
+            m_keys++;
+            return;
+        }
+
+        depth += match;
+
+        // key ends at node
+        if (depth == i_key.size())
+        {
+            if (!node->is_key)
+            {
+                m_keys++;
+            }
+            node->is_key = true;
+            node->value = static_cast<int>(m_count);
+            return;
+        }
+
+        const std::uint8_t byte = static_cast<std::uint8_t>(i_key[depth]);
+        Node ** next = find_child_ref(node, byte);
+        if (next == nullptr)
+        {
+            // rest of key goes to new leaf
+            Node * leaf = make_node(NODE4);
+            set_prefix(leaf, i_key.data() + depth + 1, i_key.size() - depth - 1);
+            leaf->is_key = true;
+            leaf->value = static_cast<int>(m_count);
+            add_child(ref, byte, leaf);
+
+            m_keys++;
+            return;
+        }
+
+        // move to next node
+        ref = next;
+        depth++;
+    }
+}
+
+/**
+* @brief Searches key in trie.
+* @param[in] i_key Key to be searched.
+* @return True if key is present in trie or False otherwise.
+*/
+bool RadixTrie::search(const std::string & i_key) const
+{
+    const Node * node = m_root;
+    std::size_t depth = 0;
+
+    for (;;)
+    {
+        // whole compressed path should match
+        if (!match_prefix(node, i_key, depth))
+        {
+            return false;
+        }
+        depth += node->length;
+
+        if (depth == i_key.size())
+        {
+            return node->is_key;
+        }
+
+        node = find_child(node, static_cast<std::uint8_t>(i_key[depth]));
+        if (node == nullptr)
+        {
+            return false;
+        }
+        depth++;
+    }
+}
+
+/**
+* @brief Removes key from trie.
+* @param[in] i_key Given key.
+*/
+void RadixTrie::delete_key(const std::string & i_key)
+{
+    // references to nodes on path and bytes leading to them
+    std::vector<Node **> refs(1, &m_root);
+    std::vector<std::uint8_t> bytes(1, 0);
+    std::size_t depth = 0;
+
+    for (;;)
+    {
+        Node * node = *refs.back();
+        if (!match_prefix(node, i_key, depth))
+        {
+            return;
+        }
+        depth += node->length;
+
+        if (depth == i_key.size())
+        {
+            break;
+        }
+
+        const std::uint8_t byte = static_cast<std::uint8_t>(i_key[depth]);
+        Node ** next = find_child_ref(node, byte);
+        if (next == nullptr)
+        {
+            return;
+        }
+        refs.push_back(next);
+        bytes.push_back(byte);
+        depth++;
+    }
+
+    Node * node = *refs.back();
+    if (!node->is_key)
+    {
+        return;
+    }
+
+    // unmark key
+    node->is_key = false;
+    node->value = 0;
+    m_keys--;
+
+    // node without children is removed from parent
+    if (node->count == 0 && refs.size() > 1)
+    {
+        free_node(node);
+        refs.pop_back();
+        remove_child(refs.back(), bytes.back());
+        bytes.pop_back();
+        node = *refs.back();
+    }
+
+    // node with single child is merged with it (root keeps its place)
+    if (node->count == 1 && !node->is_key && refs.size() > 1)
+    {
+        std::vector<std::uint8_t> child_bytes;
+        std::vector<Node *> children;
+        collect_children(node, child_bytes, children);
+
+        Node * child = children[0];
+        std::string path(prefix_data(node), node->length);
+        path += static_cast<char>(child_bytes[0]);
+        path.append(prefix_data(child), child->length);
+        set_prefix(child, path.data(), path.size());
+        *refs.back() = child;
+        free_node(node);
+    }
+}
+
+/**
+* @brief Finds longest prefix of input string which is in trie keys.
+* @param[in] i_key Key to be searched.
+* @return Key from trie which is longest prefix of input key.
+*/
+std::string RadixTrie::longest_prefix(const std::string & i_key) const
+{
+    const Node * node = m_root;
+    std::size_t depth = 0;
+    std::size_t prev_pos = 0;
+
+    for (;;)
+    {
+        if (!match_prefix(node, i_key, depth))
+        {
+            break;
+        }
+        depth += node->length;
+
+        // store prevoius matching prefix
+        if (node->is_key)
+        {
+            prev_pos = depth;
+        }
+
+        if (depth == i_key.size())
+        {
+            break;
+        }
+
+        node = find_child(node, static_cast<std::uint8_t>(i_key[depth]));
+        if (node == nullptr)
+        {
+            break;
+        }
+        depth++;
+    }
+
+    return i_key.substr(0, prev_pos);
+}
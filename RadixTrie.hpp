@@ -0,0 +1,187 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Path compressed radix trie with adaptive nodes (ART-style Node4/16/48/256).
+ *
+ * Each node holds byte span of compressed path in front of it, so chains of
+ * single-child nodes collapse into one node. Node type grows and shrinks with fan-out.
+ * Short paths are stored inside of node, only longer ones take separate allocation.
+ */
+class RadixTrie
+{
+public:
+    /**
+     * @brief Kinds of nodes by maximal number of children.
+     */
+    enum NodeType
+    {
+        NODE4,
+        NODE16,
+        NODE48,
+        NODE256
+    };
+
+    /**
+     * @brief Maximal length of compressed path stored inside of node.
+     */
+    static const std::size_t PREFIX_INLINE = 8;
+
+    /**
+     * @brief Compressed path, bytes in place of pointer if path is short (ART-style).
+     */
+    union Prefix
+    {
+        char bytes[PREFIX_INLINE];      /**< Path not longer than PREFIX_INLINE. */
+        char * data;                    /**< Longer path.                        */
+    };
+
+    /**
+     * @brief Common part of all nodes.
+     */
+    struct Node
+    {
+        Prefix prefix;          /**< Compressed path in front of node.   */
+        std::uint32_t length;   /**< Length of compressed path.          */
+        int value;              /**< Value of key ending at node.        */
+        bool is_key;            /**< Indicates end of key.               */
+        std::uint8_t type;      /**< Type of node.                       */
+        std::uint16_t count;    /**< Number of children.                 */
+    };
+
+    /**
+     * @brief Node with up to 4 children, sorted keys.
+     */
+    struct Node4 : Node
+    {
+        std::uint8_t keys[4];           /**< Bytes of children.     */
+        Node * children[4];             /**< Children.              */
+    };
+
+    /**
+     * @brief Node with up to 16 children, sorted keys.
+     */
+    struct Node16 : Node
+    {
+        std::uint8_t keys[16];          /**< Bytes of children.     */
+        Node * children[16];            /**< Children.              */
+    };
+
+    /**
+     * @brief Node with up to 48 children, byte indexed slots.
+     */
+    struct Node48 : Node
+    {
+        std::uint8_t index[256];        /**< Slot of byte + 1 (0 - absent). */
+        Node * children[48];            /**< Children.                      */
+    };
+
+    /**
+     * @brief Node with up to 256 children, direct array.
+     */
+    struct Node256 : Node
+    {
+        Node * children[256];           /**< Children.              */
+    };
+
+    /**
+     * @brief Default constructor.
+     */
+    RadixTrie();
+
+    RadixTrie(const RadixTrie &) = delete;
+    RadixTrie & operator=(const RadixTrie &) = delete;
+
+    /**
+     * @brief Destructor.
+     */
+    ~RadixTrie();
+
+    /**
+     * @brief Gets number of keys in trie.
+     */
+    std::size_t size() const
+    {
+        return m_keys;
+    }
+
+    /**
+     * @brief Gets number of allocated nodes.
+     */
+    std::size_t num_nodes() const
+    {
+        return m_nodes;
+    }
+
+    /**
+     * @brief Adds new key to trie.
+     * @param[in] i_key Key to be added.
+     */
+    void insert(const std::string & i_key);
+
+    /**
+     * @brief Searches key in trie.
+     * @param[in] i_key Key to be searched.
+     * @return True if key is present in trie or False otherwise.
+     */
+    bool search(const std::string & i_key) const;
+
+    /**
+     * @brief Removes key from trie.
+     * @param[in] i_key Given key.
+     */
+    void delete_key(const std::string & i_key);
+
+    /**
+     * @brief Finds longest prefix of input string which is in trie keys.
+     * @param[in] i_key Key to be searched.
+     * @return Key from trie which is longest prefix of input key.
+     */
+    std::string longest_prefix(const std::string & i_key) const;
+
+private:
+    Node * m_root;              /**< Root of trie.                */
+    std::size_t m_count;        /**< Number of insertions.        */
+    std::size_t m_keys;         /**< Number of keys in trie.      */
+    std::size_t m_nodes;        /**< Number of allocated nodes.   */
+
+    /**
+     * @brief Allocates empty node of given type.
+     */
+    Node * make_node(NodeType i_type);
+
+    /**
+     * @brief Releases node (without children).
+     */
+    void free_node(Node * i_node);
+
+    /**
+     * @brief Releases node and all its descendants.
+     */
+    void free_tree(Node * i_node);
+
+    /**
+     * @brief Replaces node by node of other type with the same content.
+     * @param[in,out] io_ref Reference to node in parent.
+     * @param[in] i_type New type.
+     */
+    void change_type(Node ** io_ref, NodeType i_type);
+
+    /**
+     * @brief Adds child, grows node if it is full.
+     * @param[in,out] io_ref Reference to node in parent.
+     * @param[in] i_byte Byte of child.
+     * @param[in] i_child Child to be added.
+     */
+    void add_child(Node ** io_ref, std::uint8_t i_byte, Node * i_child);
+
+    /**
+     * @brief Removes child, shrinks node if it is sparse.
+     * @param[in,out] io_ref Reference to node in parent.
+     * @param[in] i_byte Byte of child.
+     */
+    void remove_child(Node ** io_ref, std::uint8_t i_byte);
+};
@@ -2,6 +2,7 @@
 #include <vector>
 #include <algorithm>
 #include <limits>
+#include <cmath>
 
 #include "RangeMinimumQuery.hpp"
 
@@ -51,7 +52,7 @@ namespace
     * @param[in] i_idx Current index.
     * @return Minimum of array values in given range.
     */
-    int get_min_util(std::vector<int> & i_tree, int i_rleft, int i_rright, int i_left, int i_right, int i_idx)
+    int get_min_util(const std::vector<int> & i_tree, int i_rleft, int i_rright, int i_left, int i_right, int i_idx)
     {
         // check if segment of node is part of given range
         if (i_left <= i_rleft && i_rright <= i_right)
@@ -101,7 +102,7 @@ void RangeMinimumQuery::construct(const std::vector<int> & i_arr)
 * @param[in] i_right Right border.
 * @return Minimu of given range.
 */
-int RangeMinimumQuery::get_min(int i_left, int i_right)
+int RangeMinimumQuery::get_min(int i_left, int i_right) const
 {
     if (i_left < 0 || i_right > static_cast<int>(m_size) - 1 || i_left > i_right)
     {
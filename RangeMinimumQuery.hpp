@@ -18,7 +18,7 @@ public:
     * @param[in] i_right Right border.
     * @return Minimum of given range.
     */
-    int get_min(int i_left, int i_right);
+    int get_min(int i_left, int i_right) const;
 
 private:
     std::vector<int> m_seg_tree;      /**< Segment tree data. */
@@ -0,0 +1,122 @@
+#include <cstddef>
+#include <vector>
+#include <algorithm>
+
+#include "RangeQueryBatch.hpp"
+
+namespace
+{
+    /**
+     * @brief Checks wether query range is inside array.
+     */
+    bool is_valid(const RangeQuery & i_query, std::size_t i_size)
+    {
+        return i_query.left >= 0 && i_query.left <= i_query.right && i_query.right < static_cast<int>(i_size);
+    }
+}
+
+/**
+* @brief Constructor.
+* @param[in] i_arr Input array.
+*/
+DistinctCountState::DistinctCountState(const std::vector<int> & i_arr)
+    : m_ids(i_arr.size())
+    , m_distinct(0)
+{
+    // compress values to 0..k-1
+    std::vector<int> values = i_arr;
+    std::sort(values.begin(), values.end());
+    values.erase(std::unique(values.begin(), values.end()), values.end());
+
+    for (std::size_t pos = 0; pos < i_arr.size(); ++pos)
+    {
+        m_ids[pos] = std::lower_bound(values.begin(), values.end(), i_arr[pos]) - values.begin();
+    }
+
+    m_count = std::vector<int>(values.size(), 0);
+}
+
+/**
+* @brief Answers batch of range sum queries.
+* @param[in] i_arr Input array.
+* @param[in] i_queries Range queries.
+* @return Sum of each range (-1 for invalid range).
+*/
+std::vector<long long> batch_range_sum(const std::vector<int> & i_arr, const std::vector<RangeQuery> & i_queries)
+{
+    // sum is decomposable, one pass of prefix sums answers all queries
+    std::vector<long long> prefix(i_arr.size() + 1, 0);
+    for (std::size_t pos = 0; pos < i_arr.size(); ++pos)
+    {
+        prefix[pos + 1] = prefix[pos] + i_arr[pos];
+    }
+
+    std::vector<long long> res(i_queries.size(), -1);
+    for (std::size_t pos = 0; pos < i_queries.size(); ++pos)
+    {
+        if (is_valid(i_queries[pos], i_arr.size()))
+        {
+            res[pos] = prefix[i_queries[pos].right + 1] - prefix[i_queries[pos].left];
+        }
+    }
+
+    return res;
+}
+
+/**
+* @brief Answers batch of range minimum queries by one sweep over right borders.
+* @param[in] i_arr Input array.
+* @param[in] i_queries Range queries.
+* @return Minimum of each range (-1 for invalid range).
+*/
+std::vector<int> batch_range_min(const std::vector<int> & i_arr, const std::vector<RangeQuery> & i_queries)
+{
+    std::vector<int> res(i_queries.size(), -1);
+
+    // valid queries sorted by right border
+    std::vector<std::size_t> order;
+    for (std::size_t pos = 0; pos < i_queries.size(); ++pos)
+    {
+        if (is_valid(i_queries[pos], i_arr.size()))
+        {
+            order.push_back(pos);
+        }
+    }
+    std::sort(order.begin(), order.end(), [&i_queries](std::size_t i_a, std::size_t i_b)
+    {
+        return i_queries[i_a].right < i_queries[i_b].right;
+    });
+
+    // indices of increasing values, minimum of left..right is first index not less than left
+    std::vector<int> stack;
+    std::size_t next = 0;
+    for (int pos = 0; pos < static_cast<int>(i_arr.size()) && next < order.size(); ++pos)
+    {
+        while (!stack.empty() && i_arr[stack.back()] >= i_arr[pos])
+        {
+            stack.pop_back();
+        }
+        stack.push_back(pos);
+
+        // answer all queries ending at current position
+        for (; next < order.size() && i_queries[order[next]].right == pos; ++next)
+        {
+            const int left = i_queries[order[next]].left;
+            res[order[next]] = i_arr[*std::lower_bound(stack.begin(), stack.end(), left)];
+        }
+    }
+
+    return res;
+}
+
+/**
+* @brief Answers batch of distinct count queries using Mo's order.
+* @param[in] i_arr Input array.
+* @param[in] i_queries Range queries.
+* @param[in] i_threads Maximal number of threads (0 - hardware concurrency).
+* @return Number of distinct values in each range (0 for invalid range).
+*/
+std::vector<int> batch_distinct_count(const std::vector<int> & i_arr, const std::vector<RangeQuery> & i_queries, std::size_t i_threads)
+{
+    return mo_batch(i_queries, i_arr.size(), DistinctCountState(i_arr), i_threads);
+}
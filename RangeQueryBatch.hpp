@@ -0,0 +1,207 @@
+#pragma once
+
+#include <cstddef>
+#include <cmath>
+#include <vector>
+#include <thread>
+#include <algorithm>
+
+/**
+ * @brief Range query left..right (inclusive borders).
+ */
+struct RangeQuery
+{
+    int left;       /**< Left border.  */
+    int right;      /**< Right border. */
+};
+
+/**
+ * @brief Answers batch of range queries in Mo's order, results are in original order.
+ *
+ * State is copyable window aggregate with add(idx), remove(idx) and result(),
+ * window moves between neighbouring queries instead of recalculating each range.
+ * Sorted queries are split into contiguous partitions, each thread owns a copy of state
+ * and gets at least 4096 queries.
+ *
+ * @tparam State Type of window aggregate, defines result_type.
+ * @param[in] i_queries Range queries.
+ * @param[in] i_size Number of elements in array.
+ * @param[in] i_proto Empty state copied by each thread.
+ * @param[in] i_threads Maximal number of threads (0 - hardware concurrency).
+ * @return Result of each query (default value for invalid range).
+ */
+template<class State>
+std::vector<typename State::result_type> mo_batch(const std::vector<RangeQuery> & i_queries, std::size_t i_size, const State & i_proto, std::size_t i_threads = 0)
+{
+    const std::size_t q = i_queries.size();
+    std::vector<typename State::result_type> res(q, typename State::result_type());
+
+    // valid queries only
+    std::vector<std::size_t> order;
+    for (std::size_t pos = 0; pos < q; ++pos)
+    {
+        const RangeQuery & query = i_queries[pos];
+        if (query.left >= 0 && query.left <= query.right && query.right < static_cast<int>(i_size))
+        {
+            order.push_back(pos);
+        }
+    }
+
+    if (order.empty())
+    {
+        return res;
+    }
+
+    // block size which balances moves of both borders
+    const int block = std::max(1, static_cast<int>(i_size / std::sqrt(static_cast<double>(order.size()))));
+
+    // sort by block of left border, right border goes back and forth
+    std::sort(order.begin(), order.end(), [&i_queries, block](std::size_t i_a, std::size_t i_b)
+    {
+        const RangeQuery & a = i_queries[i_a];
+        const RangeQuery & b = i_queries[i_b];
+        const int ablock = a.left / block;
+        const int bblock = b.left / block;
+        if (ablock != bblock)
+        {
+            return ablock < bblock;
+        }
+        return (ablock % 2 == 0) ? (a.right < b.right) : (a.right > b.right);
+    });
+
+    // process one partition of sorted queries
+    auto run = [&i_queries, &i_proto, &order, &res](std::size_t i_begin, std::size_t i_end)
+    {
+        State state = i_proto;
+        // current window is empty
+        int cur_left = 0;
+        int cur_right = -1;
+
+        for (std::size_t pos = i_begin; pos < i_end; ++pos)
+        {
+            const RangeQuery & query = i_queries[order[pos]];
+
+            // extend window first, then shrink
+            while (cur_left > query.left)
+            {
+                state.add(--cur_left);
+            }
+            while (cur_right < query.right)
+            {
+                state.add(++cur_right);
+            }
+            while (cur_left < query.left)
+            {
+                state.remove(cur_left++);
+            }
+            while (cur_right > query.right)
+            {
+                state.remove(cur_right--);
+            }
+
+            res[order[pos]] = state.result();
+        }
+    };
+
+    // each thread copies state and walks window to its first query, small batches stay serial
+    const std::size_t PARALLEL_GRAIN = 1 << 12;
+
+    std::size_t threads = (i_threads == 0) ? std::thread::hardware_concurrency() : i_threads;
+    threads = std::max(std::size_t(1), std::min(threads, order.size() / PARALLEL_GRAIN));
+
+    if (threads == 1)
+    {
+        run(0, order.size());
+        return res;
+    }
+
+    std::vector<std::thread> workers;
+    const std::size_t chunk = (order.size() + threads - 1) / threads;
+    for (std::size_t begin = 0; begin < order.size(); begin += chunk)
+    {
+        workers.push_back(std::thread(run, begin, std::min(begin + chunk, order.size())));
+    }
+    for (std::size_t pos = 0; pos < workers.size(); ++pos)
+    {
+        workers[pos].join();
+    }
+
+    return res;
+}
+
+/**
+ * @brief Window aggregate which counts distinct values, for use with mo_batch.
+ */
+class DistinctCountState
+{
+public:
+    typedef int result_type;
+
+    /**
+     * @brief Constructor.
+     * @param[in] i_arr Input array.
+     */
+    DistinctCountState(const std::vector<int> & i_arr);
+
+    /**
+     * @brief Adds element to window.
+     * @param[in] i_idx Index in array.
+     */
+    void add(int i_idx)
+    {
+        if (m_count[m_ids[i_idx]]++ == 0)
+        {
+            m_distinct++;
+        }
+    }
+
+    /**
+     * @brief Removes element from window.
+     * @param[in] i_idx Index in array.
+     */
+    void remove(int i_idx)
+    {
+        if (--m_count[m_ids[i_idx]] == 0)
+        {
+            m_distinct--;
+        }
+    }
+
+    /**
+     * @brief Gets number of distinct values in window.
+     */
+    int result() const
+    {
+        return m_distinct;
+    }
+
+private:
+    std::vector<int> m_ids;       /**< Compressed values of array.      */
+    std::vector<int> m_count;     /**< Occurrences of value in window.  */
+    int m_distinct;               /**< Number of distinct values.       */
+};
+
+/**
+ * @brief Answers batch of range sum queries.
+ * @param[in] i_arr Input array.
+ * @param[in] i_queries Range queries.
+ * @return Sum of each range (-1 for invalid range).
+ */
+std::vector<long long> batch_range_sum(const std::vector<int> & i_arr, const std::vector<RangeQuery> & i_queries);
+
+/**
+ * @brief Answers batch of range minimum queries by one sweep over right borders.
+ * @param[in] i_arr Input array.
+ * @param[in] i_queries Range queries.
+ * @return Minimum of each range (-1 for invalid range).
+ */
+std::vector<int> batch_range_min(const std::vector<int> & i_arr, const std::vector<RangeQuery> & i_queries);
+
+/**
+ * @brief Answers batch of distinct count queries using Mo's order.
+ * @param[in] i_arr Input array.
+ * @param[in] i_queries Range queries.
+ * @param[in] i_threads Maximal number of threads (0 - hardware concurrency).
+ * @return Number of distinct values in each range (0 for invalid range).
+ */
+std::vector<int> batch_distinct_count(const std::vector<int> & i_arr, const std::vector<RangeQuery> & i_queries, std::size_t i_threads = 0);
@@ -0,0 +1,257 @@
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief Minimum operation for Segment Tree.
+ * @tparam ValueType Type of values.
+ */
+template<class ValueType>
+struct MinOp
+{
+    /**
+     * @brief Neutral element of operation.
+     */
+    static ValueType identity()
+    {
+        return std::numeric_limits<ValueType>::max();
+    }
+
+    /**
+     * @brief Combines two values.
+     */
+    ValueType operator()(const ValueType & i_left, const ValueType & i_right) const
+    {
+        return (i_right < i_left) ? i_right : i_left;
+    }
+};
+
+/**
+ * @brief Maximum operation for Segment Tree.
+ * @tparam ValueType Type of values.
+ */
+template<class ValueType>
+struct MaxOp
+{
+    /**
+     * @brief Neutral element of operation.
+     */
+    static ValueType identity()
+    {
+        return std::numeric_limits<ValueType>::lowest();
+    }
+
+    /**
+     * @brief Combines two values.
+     */
+    ValueType operator()(const ValueType & i_left, const ValueType & i_right) const
+    {
+        return (i_left < i_right) ? i_right : i_left;
+    }
+};
+
+/**
+ * @brief Sum operation for Segment Tree.
+ * @tparam ValueType Type of values.
+ */
+template<class ValueType>
+struct SumOp
+{
+    /**
+     * @brief Neutral element of operation.
+     */
+    static ValueType identity()
+    {
+        return ValueType();
+    }
+
+    /**
+     * @brief Combines two values.
+     */
+    ValueType operator()(const ValueType & i_left, const ValueType & i_right) const
+    {
+        return i_left + i_right;
+    }
+};
+
+/**
+ * @brief Greatest common divisor operation for Segment Tree.
+ *
+ * Result is non-negative, except gcd of minimal signed value with 0 or itself
+ * which is not representable and is converted back to ValueType.
+ *
+ * @tparam ValueType Integral type of values.
+ */
+template<class ValueType>
+struct GcdOp
+{
+    /**
+     * @brief Neutral element of operation.
+     */
+    static ValueType identity()
+    {
+        return ValueType();
+    }
+
+    /**
+     * @brief Combines two values.
+     */
+    ValueType operator()(const ValueType & i_left, const ValueType & i_right) const
+    {
+        // Euclid on absolute values, unsigned type holds absolute value of minimal value
+        Unsigned left = abs_value(i_left);
+        Unsigned right = abs_value(i_right);
+        while (right != 0)
+        {
+            Unsigned tmp = left % right;
+            left = right;
+            right = tmp;
+        }
+        return static_cast<ValueType>(left);
+    }
+
+private:
+    static_assert(std::is_integral<ValueType>::value, "GcdOp requires integral type");
+
+    typedef typename std::make_unsigned<ValueType>::type Unsigned;
+
+    /**
+     * @brief Absolute value without overflow.
+     */
+    static Unsigned abs_value(const ValueType & i_val)
+    {
+        if constexpr (std::is_signed<ValueType>::value)
+        {
+            if (i_val < 0)
+            {
+                return Unsigned(0) - static_cast<Unsigned>(i_val);
+            }
+        }
+        return static_cast<Unsigned>(i_val);
+    }
+};
+
+/**
+ * @brief Non-recursive bottom-up Segment Tree with point update and range query.
+ *
+ * Leaves are stored at positions size..2*size-1 where size is power of two,
+ * node i is combination of nodes 2i and 2i+1. Queries don't modify tree, so
+ * they can be executed concurrently by many readers.
+ *
+ * @tparam ValueType Type of values stored in tree.
+ * @tparam Combine Associative operation with static identity().
+ */
+template<class ValueType, class Combine = MinOp<ValueType>>
+class SegmentTree
+{
+public:
+    /**
+     * @brief Constructs tree from given array.
+     * @param[in] i_arr Input array.
+     */
+    SegmentTree(const std::vector<ValueType> & i_arr)
+        : m_count(i_arr.size())
+    {
+        // round up to power of two
+        m_size = 1;
+        while (m_size < m_count)
+        {
+            m_size *= 2;
+        }
+
+        m_tree = std::vector<ValueType>(2 * m_size, Combine::identity());
+
+        // fill leaves
+        for (std::size_t pos = 0; pos < m_count; ++pos)
+        {
+            m_tree[m_size + pos] = i_arr[pos];
+        }
+
+        // fill inner nodes
+        for (std::size_t pos = m_size - 1; pos > 0; --pos)
+        {
+            m_tree[pos] = m_op(m_tree[2 * pos], m_tree[2 * pos + 1]);
+        }
+    }
+
+    /**
+     * @brief Gets number of elements.
+     */
+    std::size_t size() const
+    {
+        return m_count;
+    }
+
+    /**
+     * @brief Updates value in array at given position.
+     * @param[in] i_pos Position in array.
+     * @param[in] i_new_val New value.
+     */
+    void update(std::size_t i_pos, const ValueType & i_new_val)
+    {
+        if (i_pos >= m_count)
+        {
+            return;
+        }
+
+        i_pos += m_size;
+        m_tree[i_pos] = i_new_val;
+
+        // recalculate parents up to root
+        for (i_pos /= 2; i_pos > 0; i_pos /= 2)
+        {
+            m_tree[i_pos] = m_op(m_tree[2 * i_pos], m_tree[2 * i_pos + 1]);
+        }
+    }
+
+    /**
+     * @brief Combines values from array in given range.
+     * @param[in] i_left Left border.
+     * @param[in] i_right Right border.
+     * @return Result of operation over range or identity for invalid range.
+     */
+    ValueType query(std::size_t i_left, std::size_t i_right) const
+    {
+        if (i_left > i_right || i_right >= m_count)
+        {
+            return Combine::identity();
+        }
+
+        // results from left and right borders, keeps order of operands
+        ValueType lres = Combine::identity();
+        ValueType rres = Combine::identity();
+
+        // half-open range of leaves
+        for (i_left += m_size, i_right += m_size + 1; i_left < i_right; i_left /= 2, i_right /= 2)
+        {
+            if (i_left & 1)
+            {
+                lres = m_op(lres, m_tree[i_left++]);
+            }
+            if (i_right & 1)
+            {
+                rres = m_op(m_tree[--i_right], rres);
+            }
+        }
+
+        return m_op(lres, rres);
+    }
+
+    /**
+     * @brief Gets value of single element.
+     * @param[in] i_pos Position in array.
+     */
+    const ValueType & get(std::size_t i_pos) const
+    {
+        return m_tree[m_size + i_pos];
+    }
+
+private:
+    std::vector<ValueType> m_tree;    /**< Segment tree data.            */
+    std::size_t m_count;              /**< Number of elements.           */
+    std::size_t m_size;               /**< Number of leaves.             */
+    Combine m_op;                     /**< Operation of tree.            */
+};
@@ -0,0 +1,105 @@
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "ShardedReverseDNSCache.hpp"
+
+/**
+* @brief Constructor.
+* @param[in] i_num_shards Number of shards.
+*/
+ShardedReverseDNSCache::ShardedReverseDNSCache(std::size_t i_num_shards)
+    : m_shards(new Shard[i_num_shards > 0 ? i_num_shards : 1])
+    , m_num_shards(i_num_shards > 0 ? i_num_shards : 1)
+{}
+
+/**
+* @brief Gets shard of address.
+*/
+std::size_t ShardedReverseDNSCache::shard_of(std::string_view i_ip) const
+{
+    return std::hash<std::string_view>()(i_ip) % m_num_shards;
+}
+
+/**
+* @brief Add IP address and corresponding URL.
+* @param[in] i_ip IP address.
+* @param[in] i_url URL.
+*/
+void ShardedReverseDNSCache::insert(std::string_view i_ip, const std::string & i_url)
+{
+    Shard & shard = m_shards[shard_of(i_ip)];
+
+    std::unique_lock<std::shared_mutex> lock(shard.lock);
+    shard.cache.insert(std::string(i_ip), i_url);
+}
+
+/**
+* @brief Reverse DNS search.
+* @param[in] i_ip IP address.
+* @return URL or nothing if IP is not found.
+*/
+std::optional<std::string> ShardedReverseDNSCache::search(std::string_view i_ip) const
+{
+    const Shard & shard = m_shards[shard_of(i_ip)];
+
+    // URL is copied while shard is locked
+    std::shared_lock<std::shared_mutex> lock(shard.lock);
+    const std::string * url = shard.cache.find(i_ip);
+    if (url == nullptr)
+    {
+        return std::nullopt;
+    }
+    return *url;
+}
+
+/**
+* @brief Reverse DNS search of many addresses, each shard is locked once.
+* @param[in] i_ips IP addresses.
+* @return URLs in the same order, nothing if IP is not found.
+*/
+std::vector<std::optional<std::string>> ShardedReverseDNSCache::search_batch(const std::vector<std::string_view> & i_ips) const
+{
+    std::vector<std::optional<std::string>> res(i_ips.size());
+
+    // positions of addresses grouped by shard
+    std::vector<std::vector<std::size_t>> groups(m_num_shards);
+    for (std::size_t pos = 0; pos < i_ips.size(); ++pos)
+    {
+        groups[shard_of(i_ips[pos])].push_back(pos);
+    }
+
+    std::vector<std::string_view> ips;
+    std::vector<const std::string *> urls;
+    for (std::size_t idx = 0; idx < m_num_shards; ++idx)
+    {
+        if (groups[idx].empty())
+        {
+            continue;
+        }
+
+        ips.clear();
+        for (std::size_t pos = 0; pos < groups[idx].size(); ++pos)
+        {
+            ips.push_back(i_ips[groups[idx][pos]]);
+        }
+
+        const Shard & shard = m_shards[idx];
+        std::shared_lock<std::shared_mutex> lock(shard.lock);
+        shard.cache.search_batch(ips, urls);
+        for (std::size_t pos = 0; pos < urls.size(); ++pos)
+        {
+            if (urls[pos] != nullptr)
+            {
+                res[groups[idx][pos]] = *urls[pos];
+            }
+        }
+    }
+
+    return res;
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "TrieUsage.hpp"
+
+/**
+ * @brief Thread safe reverse DNS cache split into shards.
+ *
+ * Shard of address is chosen by its hash, every shard has its own trie and
+ * reader-writer lock, so lookups of different shards don't contend and
+ * lookups of the same shard run in parallel.
+ */
+class ShardedReverseDNSCache
+{
+public:
+    /**
+     * @brief Constructor.
+     * @param[in] i_num_shards Number of shards.
+     */
+    ShardedReverseDNSCache(std::size_t i_num_shards = 16);
+
+    ShardedReverseDNSCache(const ShardedReverseDNSCache &) = delete;
+    ShardedReverseDNSCache & operator=(const ShardedReverseDNSCache &) = delete;
+
+    /**
+     * @brief Add IP address and corresponding URL.
+     * @param[in] i_ip IP address.
+     * @param[in] i_url URL.
+     */
+    void insert(std::string_view i_ip, const std::string & i_url);
+
+    /**
+     * @brief Reverse DNS search.
+     * @param[in] i_ip IP address.
+     * @return URL or nothing if IP is not found.
+     */
+    std::optional<std::string> search(std::string_view i_ip) const;
+
+    /**
+     * @brief Reverse DNS search of many addresses, each shard is locked once.
+     * @param[in] i_ips IP addresses.
+     * @return URLs in the same order, nothing if IP is not found.
+     */
+    std::vector<std::optional<std::string>> search_batch(const std::vector<std::string_view> & i_ips) const;
+
+    /**
+     * @brief Gets number of shards.
+     */
+    std::size_t num_shards() const
+    {
+        return m_num_shards;
+    }
+
+private:
+    /**
+     * @brief Trie with its lock, aligned to avoid false sharing of locks.
+     */
+    struct alignas(64) Shard
+    {
+        mutable std::shared_mutex lock;     /**< Protects trie.     */
+        ReverseDNSCache cache;              /**< Trie of shard.     */
+    };
+
+    /**
+     * @brief Gets shard of address.
+     */
+    std::size_t shard_of(std::string_view i_ip) const;
+
+    std::unique_ptr<Shard[]> m_shards;      /**< Shards.            */
+    std::size_t m_num_shards;               /**< Number of shards.  */
+};
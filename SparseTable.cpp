@@ -0,0 +1,88 @@
+#include <cstddef>
+#include <vector>
+
+#include "SparseTable.hpp"
+
+namespace
+{
+    /**
+     * @brief Calculates floor(log2(x)) for positive x.
+     */
+    int floor_log2(std::size_t i_x)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<int>(sizeof(unsigned long long) * 8 - 1) - __builtin_clzll(i_x);
+#else
+        int res = 0;
+        while (i_x >>= 1)
+        {
+            res++;
+        }
+        return res;
+#endif
+    }
+}
+
+/**
+* @brief Constructs sparse table from given array in O(n log n).
+* @param[in] i_arr Input array.
+*/
+SparseTable::SparseTable(const std::vector<int> & i_arr)
+    : m_arr(i_arr)
+{
+    const std::size_t n = m_arr.size();
+    if (n == 0)
+    {
+        return;
+    }
+
+    const int levels = floor_log2(n) + 1;
+    m_table = std::vector<int>(levels * n);
+
+    // ranges of length 1
+    for (std::size_t pos = 0; pos < n; ++pos)
+    {
+        m_table[pos] = static_cast<int>(pos);
+    }
+
+    // range of length 2^k is union of two ranges of length 2^(k-1)
+    for (int k = 1; k < levels; ++k)
+    {
+        const std::size_t half = std::size_t(1) << (k - 1);
+        const int * prev = &m_table[(k - 1) * n];
+        int * curr = &m_table[k * n];
+        for (std::size_t pos = 0; pos + 2 * half <= n; ++pos)
+        {
+            const int a = prev[pos];
+            const int b = prev[pos + half];
+            // prefer left most minimum
+            curr[pos] = (m_arr[b] < m_arr[a]) ? b : a;
+        }
+    }
+}
+
+/**
+* @brief Finds minimum of values from array in given range.
+* @param[in] i_left Left border.
+* @param[in] i_right Right border.
+* @return Minimum of given range and its index.
+*/
+MinResult SparseTable::get_min(int i_left, int i_right) const
+{
+    if (i_left < 0 || i_right > static_cast<int>(m_arr.size()) - 1 || i_left > i_right)
+    {
+        MinResult invalid = { -1, -1 };
+        return invalid;
+    }
+
+    const std::size_t n = m_arr.size();
+
+    // two overlapping ranges of length 2^k cover query range
+    const int k = floor_log2(i_right - i_left + 1);
+    const int a = m_table[k * n + i_left];
+    const int b = m_table[k * n + i_right - (1 << k) + 1];
+
+    const int idx = (m_arr[b] < m_arr[a]) ? b : a;
+    MinResult res = { idx, m_arr[idx] };
+    return res;
+}
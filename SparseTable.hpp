@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Result of range minimum query.
+ */
+struct MinResult
+{
+    int index;      /**< Index of left most minimum (-1 for invalid range). */
+    int value;      /**< Minimal value (-1 for invalid range).              */
+};
+
+/**
+ * @brief Immutable sparse table, answers range minimum query in O(1).
+ */
+class SparseTable
+{
+public:
+    /**
+     * @brief Constructs sparse table from given array in O(n log n).
+     * @param[in] i_arr Input array.
+     */
+    SparseTable(const std::vector<int> & i_arr);
+
+    /**
+     * @brief Gets number of elements.
+     */
+    std::size_t size() const
+    {
+        return m_arr.size();
+    }
+
+    /**
+     * @brief Finds minimum of values from array in given range.
+     * @param[in] i_left Left border.
+     * @param[in] i_right Right border.
+     * @return Minimum of given range and its index.
+     */
+    MinResult get_min(int i_left, int i_right) const;
+
+private:
+    std::vector<int> m_arr;       /**< Original array.                                 */
+    std::vector<int> m_table;     /**< Index of minimum of range [i, i + 2^k) at kn+i. */
+};
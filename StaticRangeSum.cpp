@@ -0,0 +1,233 @@
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <thread>
+#include <algorithm>
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#include "StaticRangeSum.hpp"
+
+namespace
+{
+    /**
+     * @brief Minimal number of elements processed by one thread.
+     */
+    const std::size_t PARALLEL_GRAIN = 1 << 20;
+
+    /**
+     * @brief Calculates inclusive prefix sums of chunk.
+     * @param[in] i_in Input values.
+     * @param[out] o_out Resulting prefix sums.
+     * @param[in] i_n Number of values.
+     * @param[in] i_carry Sum of all values before chunk.
+     */
+    void scan_chunk(const int * i_in, long long * o_out, std::size_t i_n, long long i_carry)
+    {
+        std::size_t pos = 0;
+
+#if defined(__AVX512F__)
+        const __m512i zero = _mm512_setzero_si512();
+        const __m512i last = _mm512_set1_epi64(7);
+        __m512i carry = _mm512_set1_epi64(i_carry);
+        for (; pos + 8 <= i_n; pos += 8)
+        {
+            __m512i x = _mm512_cvtepi32_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(i_in + pos)));
+            // in-register scan, shift lanes up by 1, 2 and 4
+            x = _mm512_add_epi64(x, _mm512_alignr_epi64(x, zero, 7));
+            x = _mm512_add_epi64(x, _mm512_alignr_epi64(x, zero, 6));
+            x = _mm512_add_epi64(x, _mm512_alignr_epi64(x, zero, 4));
+            x = _mm512_add_epi64(x, carry);
+            _mm512_storeu_si512(o_out + pos, x);
+            // broadcast last lane
+            carry = _mm512_permutexvar_epi64(last, x);
+        }
+        if (pos > 0)
+        {
+            i_carry = o_out[pos - 1];
+        }
+#elif defined(__AVX2__)
+        const __m256i zero = _mm256_setzero_si256();
+        __m256i carry = _mm256_set1_epi64x(i_carry);
+        for (; pos + 4 <= i_n; pos += 4)
+        {
+            __m256i x = _mm256_cvtepi32_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i *>(i_in + pos)));
+            // in-register scan, shift lanes up by 1 and 2
+            x = _mm256_add_epi64(x, _mm256_blend_epi32(_mm256_permute4x64_epi64(x, _MM_SHUFFLE(2, 1, 0, 0)), zero, 0x03));
+            x = _mm256_add_epi64(x, _mm256_blend_epi32(_mm256_permute4x64_epi64(x, _MM_SHUFFLE(1, 0, 0, 0)), zero, 0x0F));
+            x = _mm256_add_epi64(x, carry);
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(o_out + pos), x);
+            // broadcast last lane
+            carry = _mm256_permute4x64_epi64(x, _MM_SHUFFLE(3, 3, 3, 3));
+        }
+        if (pos > 0)
+        {
+            i_carry = o_out[pos - 1];
+        }
+#endif
+
+        // scalar tail
+        for (; pos < i_n; ++pos)
+        {
+            i_carry += i_in[pos];
+            o_out[pos] = i_carry;
+        }
+    }
+
+    /**
+     * @brief Calculates sum of chunk.
+     */
+    long long sum_chunk(const int * i_in, std::size_t i_n)
+    {
+        long long s = 0;
+        for (std::size_t pos = 0; pos < i_n; ++pos)
+        {
+            s += i_in[pos];
+        }
+        return s;
+    }
+
+    /**
+     * @brief Chooses number of threads for given amount of work.
+     */
+    std::size_t num_threads(std::size_t i_requested, std::size_t i_n)
+    {
+        std::size_t res = (i_requested == 0) ? std::thread::hardware_concurrency() : i_requested;
+        res = std::min(res, i_n / PARALLEL_GRAIN);
+        return std::max(res, std::size_t(1));
+    }
+
+    /**
+     * @brief Runs function for each chunk on separate thread.
+     * @param[in] i_n Number of elements.
+     * @param[in] i_threads Number of threads.
+     * @param[in] func Function called with (chunk number, begin, end).
+     */
+    template<class Func>
+    void parallel_chunks(std::size_t i_n, std::size_t i_threads, Func func)
+    {
+        const std::size_t chunk = (i_n + i_threads - 1) / i_threads;
+        if (i_threads == 1)
+        {
+            func(0, 0, i_n);
+            return;
+        }
+
+        std::vector<std::thread> workers;
+        for (std::size_t idx = 0; idx < i_threads; ++idx)
+        {
+            const std::size_t begin = std::min(idx * chunk, i_n);
+            const std::size_t end = std::min(begin + chunk, i_n);
+            workers.push_back(std::thread(func, idx, begin, end));
+        }
+
+        for (std::size_t idx = 0; idx < workers.size(); ++idx)
+        {
+            workers[idx].join();
+        }
+    }
+}
+
+const std::size_t BlockedStaticRangeSum::BLOCK;
+
+/**
+* @brief Constructs prefix sums of given array.
+* @param[in] i_arr Input array.
+* @param[in] i_threads Number of threads (0 - hardware concurrency).
+*/
+StaticRangeSum::StaticRangeSum(const std::vector<int> & i_arr, std::size_t i_threads)
+    : m_prefix(i_arr.size() + 1)
+{
+    const std::size_t n = i_arr.size();
+    const std::size_t threads = num_threads(i_threads, n);
+    const int * in = i_arr.data();
+    long long * out = m_prefix.data() + 1;
+
+    // first pass: sum of each chunk
+    std::vector<long long> totals(threads, 0);
+    if (threads > 1)
+    {
+        parallel_chunks(n, threads, [in, &totals](std::size_t i_idx, std::size_t i_begin, std::size_t i_end)
+        {
+            totals[i_idx] = sum_chunk(in + i_begin, i_end - i_begin);
+        });
+    }
+
+    // exclusive scan of chunk totals
+    long long acc = 0;
+    for (std::size_t idx = 0; idx < threads; ++idx)
+    {
+        const long long tmp = totals[idx];
+        totals[idx] = acc;
+        acc += tmp;
+    }
+
+    // second pass: scan of each chunk starting from its offset
+    parallel_chunks(n, threads, [in, out, &totals](std::size_t i_idx, std::size_t i_begin, std::size_t i_end)
+    {
+        scan_chunk(in + i_begin, out + i_begin, i_end - i_begin, totals[i_idx]);
+    });
+}
+
+/**
+* @brief Constructs block summaries of given array.
+* @param[in] i_arr Input array.
+* @param[in] i_threads Number of threads (0 - hardware concurrency).
+*/
+BlockedStaticRangeSum::BlockedStaticRangeSum(const std::vector<int> & i_arr, std::size_t i_threads)
+    : m_values(i_arr.begin(), i_arr.end())
+{
+    const std::size_t n = i_arr.size();
+    const std::size_t num_blocks = (n + BLOCK - 1) / BLOCK;
+    m_blocks = std::vector<long long>(num_blocks + 1, 0);
+
+    // sum of each block
+    const std::size_t threads = num_threads(i_threads, n);
+    const int * in = i_arr.data();
+    long long * blocks = m_blocks.data() + 1;
+    parallel_chunks(num_blocks, threads, [in, blocks, n](std::size_t, std::size_t i_begin, std::size_t i_end)
+    {
+        for (std::size_t blk = i_begin; blk < i_end; ++blk)
+        {
+            const std::size_t start = blk * BLOCK;
+            blocks[blk] = sum_chunk(in + start, std::min(BLOCK, n - start));
+        }
+    });
+
+    // prefix sums of blocks
+    for (std::size_t blk = 1; blk <= num_blocks; ++blk)
+    {
+        m_blocks[blk] += m_blocks[blk - 1];
+    }
+}
+
+/**
+* @brief Calculates sum of values from array in given range.
+* @param[in] i_left Left border.
+* @param[in] i_right Right border.
+* @return Sum of given range or -1 for invalid range.
+*/
+long long BlockedStaticRangeSum::get_sum(int i_left, int i_right) const
+{
+    if (i_left < 0 || i_right > static_cast<int>(size()) - 1 || i_left > i_right)
+    {
+        return -1;
+    }
+
+    const std::size_t lblock = i_left / BLOCK;
+    const std::size_t rblock = i_right / BLOCK;
+    const std::int32_t * values = m_values.data();
+
+    // range inside one block
+    if (lblock == rblock)
+    {
+        return sum_chunk(values + i_left, i_right - i_left + 1);
+    }
+
+    // whole blocks plus head of right block minus head of left block
+    return m_blocks[rblock] - m_blocks[lblock]
+        + sum_chunk(values + rblock * BLOCK, i_right - rblock * BLOCK + 1)
+        - sum_chunk(values + lblock * BLOCK, i_left - lblock * BLOCK);
+}
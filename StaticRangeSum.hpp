@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Static range sum over read-only array, O(1) query from 64-bit prefix sums.
+ *
+ * Prefix sums are built by multi-threaded two pass scan, each chunk is scanned
+ * with AVX-512 or AVX2 when compiler targets them.
+ */
+class StaticRangeSum
+{
+public:
+    /**
+     * @brief Constructs prefix sums of given array.
+     * @param[in] i_arr Input array.
+     * @param[in] i_threads Number of threads (0 - hardware concurrency).
+     */
+    StaticRangeSum(const std::vector<int> & i_arr, std::size_t i_threads = 0);
+
+    /**
+     * @brief Gets number of elements.
+     */
+    std::size_t size() const
+    {
+        return m_prefix.size() - 1;
+    }
+
+    /**
+     * @brief Calculates sum of values from array in given range.
+     * @param[in] i_left Left border.
+     * @param[in] i_right Right border.
+     * @return Sum of given range or -1 for invalid range.
+     */
+    long long get_sum(int i_left, int i_right) const
+    {
+        if (i_left < 0 || i_right > static_cast<int>(size()) - 1 || i_left > i_right)
+        {
+            return -1;
+        }
+
+        return m_prefix[i_right + 1] - m_prefix[i_left];
+    }
+
+private:
+    std::vector<long long> m_prefix;      /**< Sums of ranges 0..i-1. */
+};
+
+/**
+ * @brief Static range sum with two-level layout: 32-bit values and 64-bit block sums.
+ *
+ * Uses about half of memory of StaticRangeSum, query adds up at most two partial
+ * blocks of BLOCK contiguous values.
+ */
+class BlockedStaticRangeSum
+{
+public:
+    /**
+     * @brief Number of values summarized by one block.
+     */
+    static const std::size_t BLOCK = 32;
+
+    /**
+     * @brief Constructs block summaries of given array.
+     * @param[in] i_arr Input array.
+     * @param[in] i_threads Number of threads (0 - hardware concurrency).
+     */
+    BlockedStaticRangeSum(const std::vector<int> & i_arr, std::size_t i_threads = 0);
+
+    /**
+     * @brief Gets number of elements.
+     */
+    std::size_t size() const
+    {
+        return m_values.size();
+    }
+
+    /**
+     * @brief Calculates sum of values from array in given range.
+     * @param[in] i_left Left border.
+     * @param[in] i_right Right border.
+     * @return Sum of given range or -1 for invalid range.
+     */
+    long long get_sum(int i_left, int i_right) const;
+
+private:
+    std::vector<std::int32_t> m_values;   /**< Original values.                       */
+    std::vector<long long> m_blocks;      /**< Sums of ranges 0..k*BLOCK-1.           */
+};
@@ -0,0 +1,611 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <algorithm>
+
+#include "SuccinctBitVector.hpp"
+
+namespace
+{
+    /**
+     * @brief Number of words in block.
+     */
+    const std::size_t BLOCK_WORDS = 8;
+
+    /**
+     * @brief Number of ones (zeros) in select group.
+     */
+    const std::size_t SAMPLE = 512;
+
+    /**
+     * @brief Distance between ones (zeros) with known block inside of dense group.
+     */
+    const std::size_t SUB_SAMPLE = 64;
+
+    /**
+     * @brief Group is dense if its last block is less than this far from the first one.
+     */
+    const std::size_t DENSE_BLOCKS = 256;
+
+    /**
+     * @brief Tag in low byte of group descriptor of sparse group.
+     */
+    const std::uint64_t SPARSE = 1;
+
+    /**
+     * @brief Header of serialized vector.
+     */
+    struct Header
+    {
+        std::uint64_t size;         /**< Number of bits.                    */
+        std::uint64_t ones;         /**< Number of set bits.                */
+        std::uint64_t explicit1;    /**< Number of positions of ones.       */
+        std::uint64_t explicit0;    /**< Number of positions of zeros.      */
+    };
+
+    /**
+     * @brief Number of select groups for given number of bits.
+     */
+    std::size_t num_samples(std::size_t i_count)
+    {
+        return (i_count + SAMPLE - 1) / SAMPLE;
+    }
+
+    /**
+     * @brief Number of set bits.
+     */
+    std::size_t popcount(std::uint64_t i_word)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_popcountll(i_word);
+#else
+        std::size_t res = 0;
+        for (; i_word != 0; i_word &= i_word - 1)
+        {
+            res++;
+        }
+        return res;
+#endif
+    }
+
+    /**
+     * @brief Finds position of k-th (0-based) set bit in word.
+     * @return Position of bit, 63 if word has not enough set bits.
+     */
+    std::size_t select_in_word(std::uint64_t i_word, std::size_t i_k)
+    {
+        std::size_t pos = 0;
+
+        // skip whole bytes
+        for (; pos < 56; pos += 8, i_word >>= 8)
+        {
+            const std::size_t cnt = popcount(i_word & 0xFF);
+            if (i_k < cnt)
+            {
+                break;
+            }
+            i_k -= cnt;
+        }
+
+        // scan bits of byte
+        for (; pos < 63; ++pos, i_word >>= 1)
+        {
+            if (i_word & 1)
+            {
+                if (i_k == 0)
+                {
+                    return pos;
+                }
+                i_k--;
+            }
+        }
+        return pos;
+    }
+
+    /**
+     * @brief Access to set bits for building of select groups.
+     */
+    struct OnesAccess
+    {
+        const std::vector<std::uint64_t> & words;   /**< Bits.              */
+        const std::vector<std::uint64_t> & ranks;   /**< Ranks of blocks.   */
+
+        std::uint64_t bits(std::size_t i_word) const
+        {
+            return words[i_word];
+        }
+
+        std::uint64_t count(std::size_t i_block) const
+        {
+            return ranks[i_block];
+        }
+    };
+
+    /**
+     * @brief Access to unset bits for building of select groups.
+     */
+    struct ZerosAccess
+    {
+        const std::vector<std::uint64_t> & words;   /**< Bits.              */
+        const std::vector<std::uint64_t> & ranks;   /**< Ranks of blocks.   */
+        std::size_t size;                           /**< Number of bits.    */
+
+        std::uint64_t bits(std::size_t i_word) const
+        {
+            // bits beyond size are not zeros of vector
+            if ((i_word + 1) * 64 <= size)
+            {
+                return ~words[i_word];
+            }
+            return (i_word * 64 < size) ? ~words[i_word] & ((std::uint64_t(1) << (size % 64)) - 1) : 0;
+        }
+
+        std::uint64_t count(std::size_t i_block) const
+        {
+            return std::min<std::uint64_t>(i_block * BLOCK_WORDS * 64, size) - ranks[i_block];
+        }
+    };
+
+    /**
+     * @brief Builds select groups of ones or zeros.
+     *
+     * Every group is described by two words: block of its first one and either
+     * offsets of blocks of every SUB_SAMPLE-th one in bytes 1..7 (dense group)
+     * or SPARSE tag and index of positions of its ones (sparse group).
+     *
+     * Access provides bits(word) with ones as set bits and bits beyond size
+     * cleared, and count(block) with number of ones before block.
+     *
+     * @param[in] i_access Access to bits.
+     * @param[in] i_num_blocks Number of blocks.
+     * @param[in] i_total Number of ones.
+     * @param[out] o_select Group descriptors.
+     * @param[out] o_explicit Positions of ones of sparse groups.
+     */
+    template<class Access>
+    void build_select(const Access & i_access, std::size_t i_num_blocks, std::size_t i_total,
+                      std::vector<std::uint64_t> & o_select, std::vector<std::uint64_t> & o_explicit)
+    {
+        const std::size_t groups = num_samples(i_total);
+        const std::size_t subs = (i_total + SUB_SAMPLE - 1) / SUB_SAMPLE;
+
+        // blocks of every SUB_SAMPLE-th one and of last one of each group
+        std::vector<std::size_t> first(subs);
+        std::vector<std::size_t> last(groups);
+        std::size_t sub = 0;
+        std::size_t group = 0;
+        for (std::size_t block = 0; block < i_num_blocks; ++block)
+        {
+            const std::size_t end = i_access.count(block + 1);
+            for (; sub < subs && sub * SUB_SAMPLE < end; ++sub)
+            {
+                first[sub] = block;
+            }
+            for (; group < groups && std::min((group + 1) * SAMPLE, i_total) <= end; ++group)
+            {
+                last[group] = block;
+            }
+        }
+
+        o_select.reserve(2 * groups);
+        for (group = 0; group < groups; ++group)
+        {
+            const std::size_t begin = group * SAMPLE / SUB_SAMPLE;
+            const std::size_t base = first[begin];
+            std::uint64_t desc = 0;
+
+            if (last[group] - base < DENSE_BLOCKS)
+            {
+                // missing samples of last group repeat its last block
+                for (std::size_t pos = 1; pos < SAMPLE / SUB_SAMPLE; ++pos)
+                {
+                    const std::size_t block = (begin + pos < subs) ? first[begin + pos] : last[group];
+                    desc |= static_cast<std::uint64_t>(block - base) << (8 * pos);
+                }
+            }
+            else
+            {
+                desc = SPARSE | (static_cast<std::uint64_t>(o_explicit.size()) << 8);
+
+                // skip ones of block before the group
+                std::size_t skip = group * SAMPLE - i_access.count(base);
+                std::size_t need = std::min(SAMPLE, i_total - group * SAMPLE);
+                for (std::size_t word = base * BLOCK_WORDS; need > 0; ++word)
+                {
+                    for (std::uint64_t bits = i_access.bits(word); bits != 0 && need > 0; bits &= bits - 1)
+                    {
+                        if (skip > 0)
+                        {
+                            skip--;
+                            continue;
+                        }
+                        o_explicit.push_back(word * 64 + popcount((bits & (~bits + 1)) - 1));
+                        need--;
+                    }
+                }
+            }
+
+            o_select.push_back(base);
+            o_select.push_back(desc);
+        }
+    }
+
+    /**
+     * @brief Checks select groups read from buffer.
+     * @return True if all blocks and positions referred by groups are in bounds.
+     */
+    bool valid_select(const std::uint64_t * i_select, std::size_t i_total, const std::uint64_t * i_explicit,
+                      std::size_t i_num_explicit, std::size_t i_num_blocks, std::size_t i_size)
+    {
+        for (std::size_t group = 0; group < num_samples(i_total); ++group)
+        {
+            const std::uint64_t base = i_select[2 * group];
+            const std::uint64_t desc = i_select[2 * group + 1];
+            if (base >= i_num_blocks)
+            {
+                return false;
+            }
+
+            if ((desc & 0xFF) == SPARSE)
+            {
+                const std::size_t count = std::min(SAMPLE, i_total - group * SAMPLE);
+                if ((desc >> 8) > i_num_explicit || count > i_num_explicit - (desc >> 8))
+                {
+                    return false;
+                }
+            }
+            else if ((desc & 0xFF) != 0 || base + (desc >> 56) >= i_num_blocks)
+            {
+                return false;
+            }
+            else
+            {
+                // blocks of samples must not decrease
+                for (std::size_t pos = 2; pos < SAMPLE / SUB_SAMPLE; ++pos)
+                {
+                    if (((desc >> (8 * pos)) & 0xFF) < ((desc >> (8 * pos - 8)) & 0xFF))
+                    {
+                        return false;
+                    }
+                }
+            }
+        }
+
+        for (std::size_t pos = 0; pos < i_num_explicit; ++pos)
+        {
+            if (i_explicit[pos] >= i_size)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Finds range of blocks which contains k-th one of dense group.
+     * @param[in] i_group Descriptor of group.
+     * @param[in] i_k Number of one.
+     * @param[in] i_num_blocks Number of blocks.
+     * @param[out] o_lo First block of range.
+     * @param[out] o_hi Block after range, at most DENSE_BLOCKS after the first one of group.
+     */
+    void sub_blocks(const std::uint64_t * i_group, std::size_t i_k, std::size_t i_num_blocks, std::size_t & o_lo, std::size_t & o_hi)
+    {
+        const std::size_t sub = (i_k % SAMPLE) / SUB_SAMPLE;
+        o_lo = i_group[0] + ((i_group[1] >> (8 * sub)) & 0xFF);
+        o_hi = (sub + 1 < SAMPLE / SUB_SAMPLE) ? i_group[0] + ((i_group[1] >> (8 * sub + 8)) & 0xFF) + 1 : i_group[0] + DENSE_BLOCKS;
+        o_hi = std::min(o_hi, i_num_blocks);
+    }
+
+    /**
+     * @brief Takes array from remaining words of buffer.
+     * @return False if buffer is too small.
+     */
+    bool take(std::uint64_t & io_words, std::uint64_t i_count)
+    {
+        if (i_count > io_words)
+        {
+            return false;
+        }
+        io_words -= i_count;
+        return true;
+    }
+
+    /**
+     * @brief Appends array to buffer.
+     */
+    void append(std::vector<char> & io_buffer, const void * i_data, std::size_t i_bytes)
+    {
+        const std::size_t offset = io_buffer.size();
+        io_buffer.resize(offset + i_bytes);
+        if (i_bytes > 0)
+        {
+            std::memcpy(io_buffer.data() + offset, i_data, i_bytes);
+        }
+    }
+}
+
+/**
+* @brief Constructs empty vector.
+*/
+SuccinctBitVector::SuccinctBitVector()
+    : m_size(0)
+    , m_ones(0)
+    , m_num_explicit1(0)
+    , m_num_explicit0(0)
+    , m_num_words(0)
+    , m_num_blocks(0)
+{
+    m_ranks_data.assign(1, 0);
+    attach();
+}
+
+/**
+* @brief Constructs vector from packed bits.
+* @param[in] i_words Bits, bit pos is (words[pos / 64] >> (pos % 64)) & 1.
+* @param[in] i_size Number of bits.
+*/
+SuccinctBitVector::SuccinctBitVector(const std::vector<std::uint64_t> & i_words, std::size_t i_size)
+    : m_size(i_size)
+    , m_ones(0)
+{
+    m_num_words = (i_size + 63) / 64;
+    m_num_blocks = (m_num_words + BLOCK_WORDS - 1) / BLOCK_WORDS;
+
+    // bits beyond size are cleared
+    m_words_data.assign(m_num_blocks * BLOCK_WORDS, 0);
+    for (std::size_t pos = 0; pos < m_num_words && pos < i_words.size(); ++pos)
+    {
+        m_words_data[pos] = i_words[pos];
+    }
+    if (i_size % 64 != 0)
+    {
+        m_words_data[m_num_words - 1] &= (std::uint64_t(1) << (i_size % 64)) - 1;
+    }
+
+    // absolute ranks of blocks
+    m_ranks_data.assign(m_num_blocks + 1, 0);
+    for (std::size_t block = 0; block < m_num_blocks; ++block)
+    {
+        std::uint64_t cnt = 0;
+        for (std::size_t pos = 0; pos < BLOCK_WORDS; ++pos)
+        {
+            cnt += popcount(m_words_data[block * BLOCK_WORDS + pos]);
+        }
+        m_ranks_data[block + 1] = m_ranks_data[block] + cnt;
+    }
+    m_ones = m_ranks_data[m_num_blocks];
+
+    // select groups of ones and zeros
+    build_select(OnesAccess{ m_words_data, m_ranks_data }, m_num_blocks, m_ones, m_select1_data, m_explicit1_data);
+    build_select(ZerosAccess{ m_words_data, m_ranks_data, m_size }, m_num_blocks, m_size - m_ones, m_select0_data, m_explicit0_data);
+    m_num_explicit1 = m_explicit1_data.size();
+    m_num_explicit0 = m_explicit0_data.size();
+
+    attach();
+}
+
+/**
+* @brief Sets pointers to own arrays.
+*/
+void SuccinctBitVector::attach()
+{
+    m_words = m_words_data.data();
+    m_ranks = m_ranks_data.data();
+    m_select1 = m_select1_data.data();
+    m_select0 = m_select0_data.data();
+    m_explicit1 = m_explicit1_data.data();
+    m_explicit0 = m_explicit0_data.data();
+}
+
+/**
+* @brief Creates vector which uses serialized buffer in place.
+* @param[in] i_data Buffer written by serialize(), aligned to 8 bytes.
+* @param[in] i_bytes Size of buffer.
+* @param[out] o_vec Vector which refers to buffer.
+* @return Number of bytes used by vector or 0 if buffer is invalid.
+* @note Directory is checked, so queries stay inside of buffer. Bits are not read.
+*/
+std::size_t SuccinctBitVector::view(const void * i_data, std::size_t i_bytes, SuccinctBitVector & o_vec)
+{
+    if (i_data == nullptr || i_bytes < sizeof(Header))
+    {
+        return 0;
+    }
+
+    Header header;
+    std::memcpy(&header, i_data, sizeof(Header));
+    if (header.ones > header.size)
+    {
+        return 0;
+    }
+
+    // sizes are computed without overflow and taken from remaining words one by one
+    const std::uint64_t num_words = header.size / 64 + (header.size % 64 != 0);
+    const std::uint64_t num_blocks = num_words / BLOCK_WORDS + (num_words % BLOCK_WORDS != 0);
+    const std::uint64_t groups1 = header.ones / SAMPLE + (header.ones % SAMPLE != 0);
+    const std::uint64_t groups0 = (header.size - header.ones) / SAMPLE + ((header.size - header.ones) % SAMPLE != 0);
+
+    std::uint64_t avail = (i_bytes - sizeof(Header)) / sizeof(std::uint64_t);
+    if (!take(avail, num_blocks * BLOCK_WORDS) || !take(avail, num_blocks + 1) ||
+        !take(avail, 2 * groups1) || !take(avail, 2 * groups0) || !take(avail, header.explicit1) || !take(avail, header.explicit0))
+    {
+        return 0;
+    }
+
+    const std::uint64_t * words = reinterpret_cast<const std::uint64_t *>(static_cast<const char *>(i_data) + sizeof(Header));
+    const std::uint64_t * ranks = words + num_blocks * BLOCK_WORDS;
+    const std::uint64_t * select1 = ranks + num_blocks + 1;
+    const std::uint64_t * select0 = select1 + 2 * groups1;
+    const std::uint64_t * explicit1 = select0 + 2 * groups0;
+    const std::uint64_t * explicit0 = explicit1 + header.explicit1;
+
+    // ranks grow by at most block size and end with number of ones
+    if (ranks[0] != 0 || ranks[num_blocks] != header.ones)
+    {
+        return 0;
+    }
+    for (std::size_t block = 0; block < num_blocks; ++block)
+    {
+        if (ranks[block + 1] < ranks[block] || ranks[block + 1] - ranks[block] > BLOCK_WORDS * 64)
+        {
+            return 0;
+        }
+    }
+
+    if (!valid_select(select1, header.ones, explicit1, header.explicit1, num_blocks, header.size) ||
+        !valid_select(select0, header.size - header.ones, explicit0, header.explicit0, num_blocks, header.size))
+    {
+        return 0;
+    }
+
+    o_vec = SuccinctBitVector();
+    o_vec.m_size = header.size;
+    o_vec.m_ones = header.ones;
+    o_vec.m_num_explicit1 = header.explicit1;
+    o_vec.m_num_explicit0 = header.explicit0;
+    o_vec.m_num_words = num_words;
+    o_vec.m_num_blocks = num_blocks;
+    o_vec.m_words = words;
+    o_vec.m_ranks = ranks;
+    o_vec.m_select1 = select1;
+    o_vec.m_select0 = select0;
+    o_vec.m_explicit1 = explicit1;
+    o_vec.m_explicit0 = explicit0;
+
+    return sizeof(Header) + (explicit0 + header.explicit0 - words) * sizeof(std::uint64_t);
+}
+
+/**
+* @brief Counts set bits in range 0..pos-1.
+* @param[in] i_pos Position, not greater than size.
+*/
+std::size_t SuccinctBitVector::rank1(std::size_t i_pos) const
+{
+    const std::size_t word = i_pos / 64;
+    const std::size_t block = word / BLOCK_WORDS;
+
+    // block rank plus whole words of block
+    std::size_t res = m_ranks[block];
+    for (std::size_t pos = block * BLOCK_WORDS; pos < word; ++pos)
+    {
+        res += popcount(m_words[pos]);
+    }
+
+    // bits of last word
+    if (i_pos % 64 != 0)
+    {
+        res += popcount(m_words[word] & ((std::uint64_t(1) << (i_pos % 64)) - 1));
+    }
+
+    return res;
+}
+
+/**
+* @brief Finds position of k-th (0-based) set bit.
+* @param[in] i_k Number of bit, less than ones().
+*/
+std::size_t SuccinctBitVector::select1(std::size_t i_k) const
+{
+    // position is stored for sparse group
+    const std::uint64_t * group = m_select1 + 2 * (i_k / SAMPLE);
+    if ((group[1] & 0xFF) == SPARSE)
+    {
+        return m_explicit1[(group[1] >> 8) + i_k % SAMPLE];
+    }
+
+    // last block with rank not greater than k, less than DENSE_BLOCKS blocks apart
+    std::size_t lo = 0;
+    std::size_t hi = 0;
+    sub_blocks(group, i_k, m_num_blocks, lo, hi);
+    while (hi - lo > 1)
+    {
+        const std::size_t mid = lo + (hi - lo) / 2;
+        if (m_ranks[mid] <= i_k)
+        {
+            lo = mid;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+
+    // scan words of block
+    i_k -= m_ranks[lo];
+    std::size_t word = lo * BLOCK_WORDS;
+    for (const std::size_t last = word + BLOCK_WORDS - 1; word < last; ++word)
+    {
+        const std::size_t cnt = popcount(m_words[word]);
+        if (i_k < cnt)
+        {
+            break;
+        }
+        i_k -= cnt;
+    }
+
+    return word * 64 + select_in_word(m_words[word], i_k);
+}
+
+/**
+* @brief Finds position of k-th (0-based) unset bit.
+* @param[in] i_k Number of bit, less than size() - ones().
+*/
+std::size_t SuccinctBitVector::select0(std::size_t i_k) const
+{
+    // position is stored for sparse group
+    const std::uint64_t * group = m_select0 + 2 * (i_k / SAMPLE);
+    if ((group[1] & 0xFF) == SPARSE)
+    {
+        return m_explicit0[(group[1] >> 8) + i_k % SAMPLE];
+    }
+
+    // last block with rank not greater than k, less than DENSE_BLOCKS blocks apart
+    std::size_t lo = 0;
+    std::size_t hi = 0;
+    sub_blocks(group, i_k, m_num_blocks, lo, hi);
+    while (hi - lo > 1)
+    {
+        const std::size_t mid = lo + (hi - lo) / 2;
+        if (block_rank0(mid) <= i_k)
+        {
+            lo = mid;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+
+    // scan words of block
+    i_k -= block_rank0(lo);
+    std::size_t word = lo * BLOCK_WORDS;
+    for (const std::size_t last = word + BLOCK_WORDS - 1; word < last; ++word)
+    {
+        const std::size_t cnt = popcount(~m_words[word]);
+        if (i_k < cnt)
+        {
+            break;
+        }
+        i_k -= cnt;
+    }
+
+    return word * 64 + select_in_word(~m_words[word], i_k);
+}
+
+/**
+* @brief Appends vector to buffer, buffer stays aligned to 8 bytes.
+* @param[in,out] io_buffer Buffer.
+*/
+void SuccinctBitVector::serialize(std::vector<char> & io_buffer) const
+{
+    const Header header = { m_size, m_ones, m_num_explicit1, m_num_explicit0 };
+    append(io_buffer, &header, sizeof(Header));
+    append(io_buffer, m_words, m_num_blocks * BLOCK_WORDS * sizeof(std::uint64_t));
+    append(io_buffer, m_ranks, (m_num_blocks + 1) * sizeof(std::uint64_t));
+    append(io_buffer, m_select1, 2 * num_samples(m_ones) * sizeof(std::uint64_t));
+    append(io_buffer, m_select0, 2 * num_samples(m_size - m_ones) * sizeof(std::uint64_t));
+    append(io_buffer, m_explicit1, m_num_explicit1 * sizeof(std::uint64_t));
+    append(io_buffer, m_explicit0, m_num_explicit0 * sizeof(std::uint64_t));
+}
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Static bit vector with constant time rank and select.
+ *
+ * Absolute rank is stored for every block of 512 bits, rank inside block is
+ * counted with popcount over at most 8 words. Ones (zeros) are grouped by 512
+ * for select, like in darray. Dense group which lies in less than 256 blocks
+ * stores its first block and offsets of blocks with every 64-th one, so select
+ * searches at most 8 rank steps and scans at most 8 words. Sparse group stores
+ * positions of all its ones, which costs at most quarter of bits it spans.
+ * Directory adds about 38% to size of bits. Vector can be serialized and used
+ * in place.
+ */
+class SuccinctBitVector
+{
+public:
+    /**
+     * @brief Constructs empty vector.
+     */
+    SuccinctBitVector();
+
+    /**
+     * @brief Constructs vector from packed bits.
+     * @param[in] i_words Bits, bit pos is (words[pos / 64] >> (pos % 64)) & 1.
+     * @param[in] i_size Number of bits.
+     */
+    SuccinctBitVector(const std::vector<std::uint64_t> & i_words, std::size_t i_size);
+
+    SuccinctBitVector(const SuccinctBitVector &) = delete;
+    SuccinctBitVector & operator=(const SuccinctBitVector &) = delete;
+    SuccinctBitVector(SuccinctBitVector &&) = default;
+    SuccinctBitVector & operator=(SuccinctBitVector &&) = default;
+
+    /**
+     * @brief Creates vector which uses serialized buffer in place.
+     * @param[in] i_data Buffer written by serialize(), aligned to 8 bytes.
+     * @param[in] i_bytes Size of buffer.
+     * @param[out] o_vec Vector which refers to buffer.
+     * @return Number of bytes used by vector or 0 if buffer is invalid.
+     * @note Directory is checked, so queries stay inside of buffer. Bits are not read.
+     */
+    static std::size_t view(const void * i_data, std::size_t i_bytes, SuccinctBitVector & o_vec);
+
+    /**
+     * @brief Gets number of bits.
+     */
+    std::size_t size() const
+    {
+        return m_size;
+    }
+
+    /**
+     * @brief Gets number of set bits.
+     */
+    std::size_t ones() const
+    {
+        return m_ones;
+    }
+
+    /**
+     * @brief Gets bit at given position.
+     */
+    bool get(std::size_t i_pos) const
+    {
+        return (m_words[i_pos / 64] >> (i_pos % 64)) & 1;
+    }
+
+    /**
+     * @brief Counts set bits in range 0..pos-1.
+     * @param[in] i_pos Position, not greater than size.
+     */
+    std::size_t rank1(std::size_t i_pos) const;
+
+    /**
+     * @brief Counts unset bits in range 0..pos-1.
+     * @param[in] i_pos Position, not greater than size.
+     */
+    std::size_t rank0(std::size_t i_pos) const
+    {
+        return i_pos - rank1(i_pos);
+    }
+
+    /**
+     * @brief Finds position of k-th (0-based) set bit.
+     * @param[in] i_k Number of bit, less than ones().
+     */
+    std::size_t select1(std::size_t i_k) const;
+
+    /**
+     * @brief Finds position of k-th (0-based) unset bit.
+     * @param[in] i_k Number of bit, less than size() - ones().
+     */
+    std::size_t select0(std::size_t i_k) const;
+
+    /**
+     * @brief Appends vector to buffer, buffer stays aligned to 8 bytes.
+     * @param[in,out] io_buffer Buffer.
+     */
+    void serialize(std::vector<char> & io_buffer) const;
+
+private:
+    /**
+     * @brief Sets pointers to own arrays.
+     */
+    void attach();
+
+    /**
+     * @brief Number of unset bits before block.
+     */
+    std::uint64_t block_rank0(std::size_t i_block) const
+    {
+        return i_block * 512 - m_ranks[i_block];
+    }
+
+    std::vector<std::uint64_t> m_words_data;      /**< Own bits.                              */
+    std::vector<std::uint64_t> m_ranks_data;      /**< Own ranks of blocks.                   */
+    std::vector<std::uint64_t> m_select1_data;    /**< Own select groups of ones.             */
+    std::vector<std::uint64_t> m_select0_data;    /**< Own select groups of zeros.            */
+    std::vector<std::uint64_t> m_explicit1_data;  /**< Own positions of ones, sparse groups.  */
+    std::vector<std::uint64_t> m_explicit0_data;  /**< Own positions of zeros, sparse groups. */
+    const std::uint64_t * m_words;                /**< Bits (own or external).                */
+    const std::uint64_t * m_ranks;                /**< Ranks of blocks (own or external).     */
+    const std::uint64_t * m_select1;              /**< Select groups of ones.                 */
+    const std::uint64_t * m_select0;              /**< Select groups of zeros.                */
+    const std::uint64_t * m_explicit1;            /**< Positions of ones of sparse groups.    */
+    const std::uint64_t * m_explicit0;            /**< Positions of zeros of sparse groups.   */
+    std::size_t m_size;                           /**< Number of bits.                        */
+    std::size_t m_ones;                           /**< Number of set bits.                    */
+    std::size_t m_num_explicit1;                  /**< Number of positions of ones.           */
+    std::size_t m_num_explicit0;                  /**< Number of positions of zeros.          */
+    std::size_t m_num_words;                      /**< Number of words.                       */
+    std::size_t m_num_blocks;                     /**< Number of blocks.                      */
+};
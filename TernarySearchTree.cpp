@@ -1,122 +1,158 @@
+#include <cstddef>
+#include <cstdint>
 #include <string>
+#include <string_view>
+#include <vector>
+#include <utility>
+#include <algorithm>
 #include <iostream>
 
 #include "TernarySearchTree.hpp"
 
+const std::uint32_t TernarySearchTree::NIL;
+
 namespace
 {
-    /**
-     * @brief Utility function which adds new key into tree.
-     * @param[in] i_root Pointer to the root of Ternary Search Tree.
-     * @param[in] i_word Word to be added.
-     * @param[in] i_depth Index in word.
-     * @return New pointer to the root of Ternary Search Tree.
-     */
-    void insert_util(Node ** i_root, const std::string & i_word, const std::size_t i_depth)
-    {
-            // tree is empty
-            if ((*i_root) == nullptr)
-            {
-                (*i_root) = new Node(i_word[i_depth]);
-            }
-
-            // insert into left subtree
-            if (i_word[i_depth] < (*i_root)->data)
-            {
-                insert_util(&((*i_root)->left), i_word, i_depth);
-            }
-            // insert into right subtree
-            else if (i_word[i_depth] > (*i_root)->data)
-            {
-                insert_util(&((*i_root)->right), i_word, i_depth);
-            }
-            // insert into equal subtree
-            else
-            {
-                if (i_depth < i_word.size())
-                {
-                    insert_util(&((*i_root)->eq), i_word, i_depth + 1);
-                }
-                // if end of word reached
-                else
-                {
-                    (*i_root)->is_end = true;
-                }
-            }
-    }
-
-    /**
-    * @brief Utility function which searches key in tree.
-    * @param[in] i_root Pointer to the root of Ternary Search Tree.
-    * @param[in] i_word Word to be searched.
-    * @param[in] i_depth Index in word.
-    * @return True if word is found and False otherwise.
-    */
-    bool search_util(Node * i_root, const std::string & i_word, const std::size_t i_depth)
-    {
-        // empty tree
-        if (i_root == nullptr)
-        {
-            return false;
-        }
-
-        // search in left tree
-        if (i_word[i_depth] < i_root->data)
-        {
-            return search_util(i_root->left, i_word, i_depth);
-        }
-
-        // search in right tree
-        if (i_word[i_depth] > i_root->data)
-        {
-            return search_util(i_root->right, i_word, i_depth);
-        }
-
-        // reach end of string
-        if (i_depth == i_word.size())
-        {
-            return i_root->is_end;
-        }
-
-        return search_util(i_root->eq, i_word, i_depth + 1);
-    }
-
     /**
     * @brief Utility function which traverse all keys in tree.
-    * @param[in] i_root Pointer to the root of Ternary Search Tree.
+    * @param[in] i_nodes Arena of nodes.
+    * @param[in] i_root Index of the root of Ternary Search Tree.
     * @param[in] o_buff Output buffer.
-    * @param[in] i_depth Index in word.
     */
-    void traverse_util(Node * i_root, char * o_buff, const std::size_t i_depth)
+    void traverse_util(const std::vector<TernarySearchTree::Node> & i_nodes, std::uint32_t i_root, std::string & o_buff)
     {
-        if (i_root != nullptr)
+        if (i_root != TernarySearchTree::NIL)
         {
+            const TernarySearchTree::Node & node = i_nodes[i_root];
+
             // move to left tree
-            traverse_util(i_root->left, o_buff, i_depth);
+            traverse_util(i_nodes, node.left, o_buff);
 
-            o_buff[i_depth] = i_root->data;
-            if (i_root->is_end)
+            o_buff.push_back(node.data);
+            if (node.is_end)
             {
-                o_buff[i_depth + 1] = '\0';
                 std::cout << o_buff << std::endl;
             }
 
             // move to eq tree
-            traverse_util(i_root->eq, o_buff, i_depth + 1);
+            traverse_util(i_nodes, node.eq, o_buff);
+            o_buff.pop_back();
 
             // move to right tree
-            traverse_util(i_root->right, o_buff, i_depth);
+            traverse_util(i_nodes, node.right, o_buff);
         }
     }
 }
 
+/**
+* @brief Builds balanced tree from set of words.
+* @param[in] i_words Words to be added.
+*/
+TernarySearchTree::TernarySearchTree(const std::vector<std::string> & i_words)
+    : m_root(NIL)
+    , m_has_empty(false)
+{
+    std::vector<std::string> words = i_words;
+    std::sort(words.begin(), words.end());
+    words.erase(std::unique(words.begin(), words.end()), words.end());
+
+    // insert median of each range before its halves
+    std::vector<std::pair<std::size_t, std::size_t>> stack(1, std::make_pair(std::size_t(0), words.size()));
+    while (!stack.empty())
+    {
+        const std::size_t begin = stack.back().first;
+        const std::size_t end = stack.back().second;
+        stack.pop_back();
+
+        if (begin == end)
+        {
+            continue;
+        }
+
+        const std::size_t mid = begin + (end - begin) / 2;
+        insert_word(words[mid]);
+
+        stack.push_back(std::make_pair(mid + 1, end));
+        stack.push_back(std::make_pair(begin, mid));
+    }
+
+    m_nodes.shrink_to_fit();
+}
+
+/**
+* @brief Allocates new node in arena.
+* @param[in] i_ch Character will be stored in node.
+* @return Index of node.
+*/
+std::uint32_t TernarySearchTree::make_node(char i_ch)
+{
+    const Node node = { i_ch, false, NIL, NIL, NIL };
+    m_nodes.push_back(node);
+    return static_cast<std::uint32_t>(m_nodes.size() - 1);
+}
+
 /**
 * @brief Adds new word into tree.
 * @param[in] i_word Word to be added.
 */
 void TernarySearchTree::insert_word(const std::string & i_word)
 {
-    insert_util(&m_root, i_word, 0);
+    if (i_word.empty())
+    {
+        m_has_empty = true;
+        return;
+    }
+
+    // link to current node is kept as index, arena may be reallocated
+    std::uint32_t parent = NIL;
+    std::uint32_t Node::* link = nullptr;
+    std::uint32_t cur = m_root;
+    std::size_t depth = 0;
+
+    for (;;)
+    {
+        // tree is empty
+        if (cur == NIL)
+        {
+            cur = make_node(i_word[depth]);
+            if (parent == NIL)
+            {
+                m_root = cur;
+            }
+            else
+            {
+                m_nodes[parent].*link = cur;
+            }
+        }
+
+        Node & node = m_nodes[cur];
+        parent = cur;
+
+        // insert into left subtree
+        if (i_word[depth] < node.data)
+        {
+            link = &Node::left;
+        }
+        // insert into right subtree
+        else if (i_word[depth] > node.data)
+        {
+            link = &Node::right;
+        }
+        // if end of word reached
+        else if (depth + 1 == i_word.size())
+        {
+            node.is_end = true;
+            return;
+        }
+        // insert into equal subtree
+        else
+        {
+            link = &Node::eq;
+            depth++;
+        }
+
+        cur = node.*link;
+    }
 }
 
 /**
@@ -124,9 +160,43 @@ void TernarySearchTree::insert_word(const std::string & i_word)
 * @param[in] i_word Word to be searched.
 * @return True if word is present in tree and False otherwise.
 */
-bool TernarySearchTree::search_word(const std::string & i_word) const
+bool TernarySearchTree::search_word(std::string_view i_word) const
 {
-    return search_util(m_root, i_word, 0);
+    if (i_word.empty())
+    {
+        return m_has_empty;
+    }
+
+    std::uint32_t cur = m_root;
+    std::size_t depth = 0;
+
+    while (cur != NIL)
+    {
+        const Node & node = m_nodes[cur];
+
+        // search in left tree
+        if (i_word[depth] < node.data)
+        {
+            cur = node.left;
+        }
+        // search in right tree
+        else if (i_word[depth] > node.data)
+        {
+            cur = node.right;
+        }
+        // reach end of string
+        else if (depth + 1 == i_word.size())
+        {
+            return node.is_end;
+        }
+        else
+        {
+            cur = node.eq;
+            depth++;
+        }
+    }
+
+    return false;
 }
 
 /**
@@ -134,6 +204,6 @@ bool TernarySearchTree::search_word(const std::string & i_word) const
 */
 void TernarySearchTree::traverse() const
 {
-    char buff[1024];
-    traverse_util(m_root, buff, 0);
-}
\ No newline at end of file
+    std::string buff;
+    traverse_util(m_nodes, m_root, buff);
+}
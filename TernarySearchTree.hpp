@@ -1,44 +1,49 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
 #include <string>
-
-/**
- * @brief Definition of Ternary Search Tree. 
- */
-struct Node
-{
-    char data;         /**< Data stored in node.       */
-    bool is_end;       /**< Indicates end of string.   */
-    Node * left;       /**< Pointer to left child.     */
-    Node * eq;         /**< Pointer to equal child.    */
-    Node * right;      /**< Pointer to right child.    */
-
-    /**
-     * @brief Tree node constructor.
-     * @param[in] i_ch Character will be stored in node.
-     */
-    Node(char i_ch)
-        : data(i_ch)
-        , is_end(false)
-        , left(nullptr)
-        , eq(nullptr)
-        , right(nullptr)
-    {}
-};
+#include <string_view>
+#include <vector>
 
 /**
  * @brief Definition of Ternary Search Tree.
+ *
+ * Nodes are stored in contiguous arena and linked by 32-bit indices, end of
+ * word is marked on node of its last character.
  */
 class TernarySearchTree
 {
 public:
+    /**
+     * @brief Definition of Ternary Search Tree node.
+     */
+    struct Node
+    {
+        char data;               /**< Data stored in node.       */
+        bool is_end;             /**< Indicates end of string.   */
+        std::uint32_t left;      /**< Index of left child.       */
+        std::uint32_t eq;        /**< Index of equal child.      */
+        std::uint32_t right;     /**< Index of right child.      */
+    };
+
+    static const std::uint32_t NIL = 0xFFFFFFFFu;   /**< Index of missing node.   */
+
     /**
      * @brief Default constructor.
      */
     TernarySearchTree()
-        : m_root(nullptr)
+        : m_root(NIL)
+        , m_has_empty(false)
     {}
 
+    /**
+     * @brief Builds balanced tree from set of words.
+     * @param[in] i_words Words to be added.
+     */
+    TernarySearchTree(const std::vector<std::string> & i_words);
+
     /**
      * @brief Adds new word into tree.
      * @param[in] i_word Word to be added.
@@ -50,13 +55,409 @@ public:
      * @param[in] i_word Word to be searched.
      * @return True if word is present in tree and False otherwise.
      */
-    bool search_word(const std::string & i_word) const;
+    bool search_word(std::string_view i_word) const;
 
     /**
      * @brief Ternary Search Tree traversal, prins all word in tree.
      */
     void traverse() const;
 
+    /**
+     * @brief Enumerates words which start with given prefix in sorted order.
+     * @tparam Func Type of function.
+     * @param[in] i_prefix Prefix of words.
+     * @param[in] func Function called with each word, returns false to stop search.
+     */
+    template<class Func>
+    void prefix_search(std::string_view i_prefix, Func func) const;
+
+    /**
+     * @brief Enumerates words which match pattern in sorted order, '?' matches any character.
+     * @tparam Func Type of function.
+     * @param[in] i_pattern Pattern of words.
+     * @param[in] func Function called with each word, returns false to stop search.
+     */
+    template<class Func>
+    void pattern_search(std::string_view i_pattern, Func func) const;
+
+    /**
+     * @brief Enumerates words of the same length within Hamming distance in sorted order.
+     * @tparam Func Type of function.
+     * @param[in] i_word Word to be compared.
+     * @param[in] i_max_dist Maximal number of different characters.
+     * @param[in] func Function called with each word, returns false to stop search.
+     */
+    template<class Func>
+    void hamming_search(std::string_view i_word, std::size_t i_max_dist, Func func) const;
+
+    /**
+     * @brief Enumerates words within Levenshtein distance in sorted order.
+     * @tparam Func Type of function.
+     * @param[in] i_word Word to be compared.
+     * @param[in] i_max_dist Maximal number of insertions, deletions and substitutions.
+     * @param[in] func Function called with each word, returns false to stop search.
+     */
+    template<class Func>
+    void levenshtein_search(std::string_view i_word, std::size_t i_max_dist, Func func) const;
+
+    /**
+     * @brief Gets number of nodes.
+     */
+    std::size_t num_nodes() const
+    {
+        return m_nodes.size();
+    }
+
 private:
-    Node * m_root;     /**< Pointer to root of tree.   */
-};
\ No newline at end of file
+    /**
+     * @brief Pending node of iterative traversal.
+     */
+    struct Frame
+    {
+        std::uint32_t node;      /**< Index of node.                          */
+        std::uint32_t depth;     /**< Position of node character in word.     */
+        std::size_t state;       /**< State of search on path to node.        */
+        bool expanded;           /**< Indicates that left subtree is pushed.  */
+    };
+
+    /**
+     * @brief Search which visits all words.
+     */
+    struct AllPolicy
+    {
+        /**
+         * @brief Checks whether left (right) subtree may contain results.
+         */
+        bool left(const Node &, std::uint32_t, std::size_t) const
+        {
+            return true;
+        }
+        bool right(const Node &, std::uint32_t, std::size_t) const
+        {
+            return true;
+        }
+
+        /**
+         * @brief Checks node, sets whether word ends at node and whether to descend.
+         */
+        void visit(const Node & i_node, std::uint32_t, std::size_t i_state, bool & o_emit, bool & o_descend, std::size_t & o_state)
+        {
+            o_emit = i_node.is_end;
+            o_descend = true;
+            o_state = i_state;
+        }
+    };
+
+    /**
+     * @brief Search of words which match pattern with '?' wildcards.
+     */
+    struct PatternPolicy
+    {
+        std::string_view pattern;     /**< Pattern of words.     */
+
+        bool left(const Node & i_node, std::uint32_t i_depth, std::size_t) const
+        {
+            return pattern[i_depth] == '?' || pattern[i_depth] < i_node.data;
+        }
+
+        bool right(const Node & i_node, std::uint32_t i_depth, std::size_t) const
+        {
+            return pattern[i_depth] == '?' || pattern[i_depth] > i_node.data;
+        }
+
+        void visit(const Node & i_node, std::uint32_t i_depth, std::size_t i_state, bool & o_emit, bool & o_descend, std::size_t & o_state)
+        {
+            const bool match = pattern[i_depth] == '?' || pattern[i_depth] == i_node.data;
+            const bool last = i_depth + 1 == pattern.size();
+            o_emit = match && last && i_node.is_end;
+            o_descend = match && !last;
+            o_state = i_state;
+        }
+    };
+
+    /**
+     * @brief Search of words within Hamming distance, state is number of mismatches.
+     */
+    struct HammingPolicy
+    {
+        std::string_view word;        /**< Word to be compared.          */
+        std::size_t max_dist;         /**< Maximal number of mismatches. */
+
+        bool left(const Node & i_node, std::uint32_t i_depth, std::size_t i_state) const
+        {
+            return i_state < max_dist || word[i_depth] < i_node.data;
+        }
+
+        bool right(const Node & i_node, std::uint32_t i_depth, std::size_t i_state) const
+        {
+            return i_state < max_dist || word[i_depth] > i_node.data;
+        }
+
+        void visit(const Node & i_node, std::uint32_t i_depth, std::size_t i_state, bool & o_emit, bool & o_descend, std::size_t & o_state)
+        {
+            o_state = i_state + (word[i_depth] != i_node.data ? 1 : 0);
+            const bool last = i_depth + 1 == word.size();
+            o_emit = o_state <= max_dist && last && i_node.is_end;
+            o_descend = o_state <= max_dist && !last;
+        }
+    };
+
+    /**
+     * @brief Search of words within Levenshtein distance, keeps row of DP table for each depth.
+     */
+    struct LevenshteinPolicy
+    {
+        std::string_view word;        /**< Word to be compared.              */
+        std::size_t max_dist;         /**< Maximal distance.                 */
+        std::vector<std::size_t> rows;   /**< Rows of DP table by depth.     */
+
+        bool left(const Node &, std::uint32_t, std::size_t) const
+        {
+            return true;
+        }
+        bool right(const Node &, std::uint32_t, std::size_t) const
+        {
+            return true;
+        }
+
+        void visit(const Node & i_node, std::uint32_t i_depth, std::size_t i_state, bool & o_emit, bool & o_descend, std::size_t & o_state)
+        {
+            const std::size_t n = word.size() + 1;
+            if (rows.size() < (i_depth + 2) * n)
+            {
+                rows.resize((i_depth + 2) * n);
+            }
+
+            // row of prefix which ends at node from row of its parent
+            const std::size_t * prev = &rows[i_depth * n];
+            std::size_t * cur = &rows[(i_depth + 1) * n];
+            cur[0] = i_depth + 1;
+            std::size_t best = cur[0];
+            for (std::size_t pos = 1; pos < n; ++pos)
+            {
+                const std::size_t subst = prev[pos - 1] + (word[pos - 1] != i_node.data ? 1 : 0);
+                cur[pos] = std::min(std::min(prev[pos] + 1, cur[pos - 1] + 1), subst);
+                best = std::min(best, cur[pos]);
+            }
+
+            // no extension of prefix can be close enough
+            o_emit = i_node.is_end && cur[n - 1] <= max_dist;
+            o_descend = best <= max_dist;
+            o_state = i_state;
+        }
+    };
+
+    /**
+     * @brief Iterative in-order traversal of subtree guided by policy.
+     * @return False if function requested to stop.
+     */
+    template<class Policy, class Func>
+    bool walk(std::uint32_t i_root, std::uint32_t i_depth, std::size_t i_state, std::string & io_buff, Policy & policy, Func & func) const;
+
+    /**
+     * @brief Allocates new node in arena.
+     * @param[in] i_ch Character will be stored in node.
+     * @return Index of node.
+     */
+    std::uint32_t make_node(char i_ch);
+
+    std::vector<Node> m_nodes;     /**< Arena of nodes.                  */
+    std::uint32_t m_root;          /**< Index of root of tree.           */
+    bool m_has_empty;              /**< Indicates empty word in tree.    */
+};
+
+/**
+* @brief Iterative in-order traversal of subtree guided by policy.
+* @return False if function requested to stop.
+*/
+template<class Policy, class Func>
+inline bool TernarySearchTree::walk(std::uint32_t i_root, std::uint32_t i_depth, std::size_t i_state, std::string & io_buff, Policy & policy, Func & func) const
+{
+    std::vector<Frame> stack;
+    const Frame start = { i_root, i_depth, i_state, false };
+    stack.push_back(start);
+
+    while (!stack.empty())
+    {
+        Frame frame = stack.back();
+        stack.pop_back();
+
+        if (frame.node == NIL)
+        {
+            continue;
+        }
+
+        const Node & node = m_nodes[frame.node];
+
+        // left subtree goes first
+        if (!frame.expanded)
+        {
+            frame.expanded = true;
+            stack.push_back(frame);
+            if (policy.left(node, frame.depth, frame.state))
+            {
+                const Frame left = { node.left, frame.depth, frame.state, false };
+                stack.push_back(left);
+            }
+            continue;
+        }
+
+        // right subtree goes after equal subtree
+        if (policy.right(node, frame.depth, frame.state))
+        {
+            const Frame right = { node.right, frame.depth, frame.state, false };
+            stack.push_back(right);
+        }
+
+        bool emit = false;
+        bool descend = false;
+        std::size_t state = frame.state;
+        policy.visit(node, frame.depth, frame.state, emit, descend, state);
+
+        io_buff.resize(frame.depth);
+        io_buff.push_back(node.data);
+
+        if (emit && !func(std::string_view(io_buff)))
+        {
+            return false;
+        }
+        if (descend)
+        {
+            const Frame eq = { node.eq, frame.depth + 1, state, false };
+            stack.push_back(eq);
+        }
+    }
+
+    return true;
+}
+
+/**
+* @brief Enumerates words which start with given prefix in sorted order.
+* @tparam Func Type of function.
+* @param[in] i_prefix Prefix of words.
+* @param[in] func Function called with each word, returns false to stop search.
+*/
+template<class Func>
+inline void TernarySearchTree::prefix_search(std::string_view i_prefix, Func func) const
+{
+    std::string buff(i_prefix);
+    AllPolicy policy;
+
+    if (i_prefix.empty())
+    {
+        if (m_has_empty && !func(std::string_view()))
+        {
+            return;
+        }
+        walk(m_root, 0, 0, buff, policy, func);
+        return;
+    }
+
+    // find node of last character of prefix
+    std::uint32_t cur = m_root;
+    std::size_t depth = 0;
+    while (cur != NIL)
+    {
+        const Node & node = m_nodes[cur];
+        if (i_prefix[depth] < node.data)
+        {
+            cur = node.left;
+        }
+        else if (i_prefix[depth] > node.data)
+        {
+            cur = node.right;
+        }
+        else if (depth + 1 == i_prefix.size())
+        {
+            break;
+        }
+        else
+        {
+            cur = node.eq;
+            depth++;
+        }
+    }
+
+    if (cur == NIL)
+    {
+        return;
+    }
+
+    if (m_nodes[cur].is_end && !func(std::string_view(buff)))
+    {
+        return;
+    }
+    walk(m_nodes[cur].eq, static_cast<std::uint32_t>(i_prefix.size()), 0, buff, policy, func);
+}
+
+/**
+* @brief Enumerates words which match pattern in sorted order, '?' matches any character.
+* @tparam Func Type of function.
+* @param[in] i_pattern Pattern of words.
+* @param[in] func Function called with each word, returns false to stop search.
+*/
+template<class Func>
+inline void TernarySearchTree::pattern_search(std::string_view i_pattern, Func func) const
+{
+    if (i_pattern.empty())
+    {
+        if (m_has_empty)
+        {
+            func(std::string_view());
+        }
+        return;
+    }
+
+    std::string buff;
+    PatternPolicy policy = { i_pattern };
+    walk(m_root, 0, 0, buff, policy, func);
+}
+
+/**
+* @brief Enumerates words of the same length within Hamming distance in sorted order.
+* @tparam Func Type of function.
+* @param[in] i_word Word to be compared.
+* @param[in] i_max_dist Maximal number of different characters.
+* @param[in] func Function called with each word, returns false to stop search.
+*/
+template<class Func>
+inline void TernarySearchTree::hamming_search(std::string_view i_word, std::size_t i_max_dist, Func func) const
+{
+    if (i_word.empty())
+    {
+        if (m_has_empty)
+        {
+            func(std::string_view());
+        }
+        return;
+    }
+
+    std::string buff;
+    HammingPolicy policy = { i_word, i_max_dist };
+    walk(m_root, 0, 0, buff, policy, func);
+}
+
+/**
+* @brief Enumerates words within Levenshtein distance in sorted order.
+* @tparam Func Type of function.
+* @param[in] i_word Word to be compared.
+* @param[in] i_max_dist Maximal number of insertions, deletions and substitutions.
+* @param[in] func Function called with each word, returns false to stop search.
+*/
+template<class Func>
+inline void TernarySearchTree::levenshtein_search(std::string_view i_word, std::size_t i_max_dist, Func func) const
+{
+    // empty word is at distance of whole input
+    if (m_has_empty && i_word.size() <= i_max_dist && !func(std::string_view()))
+    {
+        return;
+    }
+
+    std::string buff;
+    LevenshteinPolicy policy = { i_word, i_max_dist, std::vector<std::size_t>(i_word.size() + 1) };
+    for (std::size_t pos = 0; pos <= i_word.size(); ++pos)
+    {
+        policy.rows[pos] = pos;
+    }
+    walk(m_root, 0, 0, buff, policy, func);
+}
@@ -1,6 +1,10 @@
+#include <algorithm>
 #include <string>
+#include <string_view>
+#include <vector>
 
 #include "Trie.hpp"
+#include "TrieCompletion.hpp"
 
 namespace
 {
@@ -34,13 +38,72 @@ namespace
         {
             if (i_node->child[pos] != nullptr)
             {
-                return true;
+                return false;
             }
         }
 
-        return false;
+        return true;
     }
 
+    /**
+     * @brief Recalculates maximal score and presence of keys in subtree from node and its children.
+     * @param[in,out] io_node Trie node.
+     */
+    void update_max_score(Trie::TrieNode * io_node)
+    {
+        bool has_keys = is_leaf(io_node);
+        long long res = has_keys ? io_node->score : std::numeric_limits<long long>::min();
+        for (std::size_t pos = 0; pos < io_node->child.size(); ++pos)
+        {
+            const Trie::TrieNode * next = io_node->child[pos];
+            if (next != nullptr && next->has_keys)
+            {
+                res = has_keys ? std::max(res, next->max_score) : next->max_score;
+                has_keys = true;
+            }
+        }
+        io_node->max_score = res;
+        io_node->has_keys = has_keys;
+    }
+
+    /**
+     * @brief Access to Trie nodes for autocomplete.
+     */
+    struct NodeAccess
+    {
+        bool has_keys(const Trie::TrieNode * i_node) const
+        {
+            return i_node->has_keys;
+        }
+
+        long long max_score(const Trie::TrieNode * i_node) const
+        {
+            return i_node->max_score;
+        }
+
+        bool is_key(const Trie::TrieNode * i_node) const
+        {
+            return is_leaf(i_node);
+        }
+
+        long long score(const Trie::TrieNode * i_node) const
+        {
+            return i_node->score;
+        }
+
+        template<class Func>
+        void for_each_child(const Trie::TrieNode * i_node, Func i_func) const
+        {
+            for (std::size_t pos = 0; pos < i_node->child.size(); ++pos)
+            {
+                if (i_node->child[pos] != nullptr)
+                {
+                    i_func(static_cast<char>('a' + pos), static_cast<const Trie::TrieNode *>(i_node->child[pos]));
+                }
+            }
+        }
+    };
+
     /**
     * @brief Helper function.
     * @param[in] i_node Trie node.
@@ -48,7 +111,7 @@ namespace
     * @param[in] i_level Level where key is looking for.
     * @param[in] i_len Length of key.
     */
-    bool delete_key_util(Trie::TrieNode * i_node, const std::string & i_key, std::size_t i_level, std::size_t i_len)
+    bool delete_key_util(Trie::TrieNode * i_node, std::string_view i_key, std::size_t i_level, std::size_t i_len)
     {
         if (i_node != nullptr)
         {
@@ -89,12 +152,16 @@ namespace
 /**
 * @brief Adds new key to Trie.
 * @param[in] i_key Key to be added.
+* @param[in] i_score Score of key used by autocomplete.
 */
-void Trie::insert(const std::string & i_key)
+void Trie::insert(const std::string & i_key, long long i_score)
 {
     // increase number of keys
     m_count++;
 
+    // nodes on path of key
+    std::vector<TrieNode *> path(1, m_root);
+
     // copy root
     TrieNode * node = m_root;
     for (std::size_t level = 0; level < i_key.size(); ++level)
@@ -107,10 +174,18 @@ void Trie::insert(const std::string & i_key)
         }
         // move to next node
         node = node->child[idx];
+        path.push_back(node);
     }
 
     // mark last node as leaf
     node->value = m_count;
+    node->score = i_score;
+
+    // score may decrease for existing key, recalculate whole path
+    for (std::size_t pos = path.size(); pos-- > 0;)
+    {
+        update_max_score(path[pos]);
+    }
 }
 
 /**
@@ -118,7 +193,7 @@ void Trie::insert(const std::string & i_key)
 * @param[in] i_key Key to be searched.
 * @return True if key is present in Trie or False otherwise.
 */
-bool Trie::search(const std::string & i_key) const
+bool Trie::search(std::string_view i_key) const
 {
     // copy root
     TrieNode * node = m_root;
@@ -139,13 +214,31 @@ bool Trie::search(const std::string & i_key) const
 * @brief Removes key from Trie.
 * @param[in] Given key.
 */
-void Trie::delete_key(const std::string & i_key)
+void Trie::delete_key(std::string_view i_key)
 {
     const std::size_t n = i_key.size();
     if (n > 0)
     {
         delete_key_util(m_root, i_key, 0, n);
     }
+
+    // nodes which remain on path of key
+    std::vector<TrieNode *> path(1, m_root);
+    for (std::size_t level = 0; level < n; ++level)
+    {
+        TrieNode * next = path.back()->child[key_to_idx(i_key[level])];
+        if (next == nullptr)
+        {
+            break;
+        }
+        path.push_back(next);
+    }
+
+    // recalculate scores bottom-up
+    for (std::size_t pos = path.size(); pos-- > 0;)
+    {
+        update_max_score(path[pos]);
+    }
 }
 
 /**
@@ -153,11 +246,18 @@ void Trie::delete_key(const std::string & i_key)
 * @param[in] i_key Key to be searched.
 * @return Key from Trie which is longest prefix of input key.
 */
-std::string Trie::longest_prefix(const std::string & i_key) const
+std::string Trie::longest_prefix(std::string_view i_key) const
 {
-    // longest prefix
-    std::string pref;
+    return std::string(i_key.substr(0, longest_prefix_length(i_key)));
+}
 
+/**
+* @brief Finds length of longest prefix of input string which is in Trie keys, doesn't allocate.
+* @param[in] i_key Key to be searched.
+* @return Length of longest prefix or 0 if there is no such key.
+*/
+std::size_t Trie::longest_prefix_length(std::string_view i_key) const
+{
     // copy root
     TrieNode * node = m_root;
 
@@ -167,29 +267,42 @@ std::string Trie::longest_prefix(const std::string & i_key) const
     {
         int idx = key_to_idx(i_key[level]);
 
-        if (node->child[idx] != nullptr)
+        if (node->child[idx] == nullptr)
         {
-            pref += i_key[level];
-            // move to next node
-            node = node->child[idx];
-
-            // store prevoius matching prefix
-            if (is_leaf(node))
-            {
-                prev_pos = level + 1;
-            }
+            break;
         }
-        else
+
+        // move to next node
+        node = node->child[idx];
+
+        // store prevoius matching prefix
+        if (is_leaf(node))
         {
-            break;
+            prev_pos = level + 1;
         }
     }
 
-    // check if last node is leaf node
-    if (!is_leaf(node))
+    return prev_pos;
+}
+
+/**
+* @brief Finds keys with highest scores which start with given prefix.
+* @param[in] i_prefix Prefix of keys.
+* @param[in] i_k Maximal number of keys.
+* @return Keys ordered by descending score (ties by key).
+*/
+std::vector<std::string> Trie::complete(std::string_view i_prefix, std::size_t i_k) const
+{
+    // find node of prefix
+    const TrieNode * node = m_root;
+    for (std::size_t level = 0; level < i_prefix.size() && node != nullptr; ++level)
+    {
+        node = node->child[key_to_idx(i_prefix[level])];
+    }
+    if (node == nullptr)
     {
-        return std::string(pref.begin(), pref.begin() + prev_pos);
+        return std::vector<std::string>();
     }
 
-    return pref;
+    return complete_keys(NodeAccess(), node, i_prefix, i_k);
 }
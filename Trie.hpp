@@ -2,6 +2,8 @@
 
 #include <vector>
 #include <string>
+#include <string_view>
+#include <limits>
 
 /**
  * @brief Implementation of Trie data structure (an efficient information reTrieval data structure).
@@ -14,8 +16,11 @@ public:
      */
     struct TrieNode
     {
-        int value;                         /**< Value stored in node. */
-        std::vector<TrieNode *> child;     /**< Childrens of node.    */
+        int value;                         /**< Value stored in node.              */
+        long long score;                   /**< Score of key which ends in node.   */
+        long long max_score;               /**< Maximal score of keys in subtree.  */
+        bool has_keys;                     /**< Whether subtree contains any key.  */
+        std::vector<TrieNode *> child;     /**< Childrens of node.                 */
 
         /**
          * @brief Constructor.
@@ -23,6 +28,9 @@ public:
          */
         TrieNode(const std::size_t i_size)
             : value(0)
+            , score(0)
+            , max_score(std::numeric_limits<long long>::min())
+            , has_keys(false)
             , child(std::vector<TrieNode *>(i_size, nullptr))
         {}
     };
@@ -40,28 +48,60 @@ public:
     /**
      * @brief Adds new key to Trie.
      * @param[in] i_key Key to be added.
+     * @param[in] i_score Score of key used by autocomplete.
      */
-    void insert(const std::string & i_key);
+    void insert(const std::string & i_key, long long i_score = 0);
 
     /**
      * @brief Searches key in Trie.
      * @param[in] i_key Key to be searched.
      * @return True if key is present in Trie or False otherwise.
      */
-    bool search(const std::string & i_key) const;
+    bool search(std::string_view i_key) const;
 
     /**
      * @brief Removes key from Trie.
      * @param[in] Given key.
      */
-    void delete_key(const std::string & i_key);
+    void delete_key(std::string_view i_key);
 
     /**
      * @brief Finds longest prefix of input string which is in Trie keys.
      * @param[in] i_key Key to be searched.
      * @return Key from Trie which is longest prefix of input key.
      */
-    std::string longest_prefix(const std::string & i_key) const;
+    std::string longest_prefix(std::string_view i_key) const;
+
+    /**
+     * @brief Finds length of longest prefix of input string which is in Trie keys, doesn't allocate.
+     * @param[in] i_key Key to be searched.
+     * @return Length of longest prefix or 0 if there is no such key.
+     */
+    std::size_t longest_prefix_length(std::string_view i_key) const;
+
+    /**
+     * @brief Finds keys with highest scores which start with given prefix.
+     * @param[in] i_prefix Prefix of keys.
+     * @param[in] i_k Maximal number of keys.
+     * @return Keys ordered by descending score (ties by key).
+     */
+    std::vector<std::string> complete(std::string_view i_prefix, std::size_t i_k) const;
+
+    /**
+     * @brief Gets root of Trie.
+     */
+    const TrieNode * root() const
+    {
+        return m_root;
+    }
+
+    /**
+     * @brief Gets alphabet size.
+     */
+    std::size_t alphabet_size() const
+    {
+        return m_size;
+    }
 
 private:
     TrieNode * m_root;                     /**< Root of trie.            */
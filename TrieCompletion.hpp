@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstddef>
+#include <queue>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Candidate of autocomplete: whole subtree or single key.
+ * @tparam NodeRef Reference to trie node.
+ */
+template<class NodeRef>
+struct CompletionCandidate
+{
+    long long score;                    /**< Score or upper bound of scores.  */
+    bool is_key;                        /**< Indicates single key.            */
+    std::string key;                    /**< Key or prefix of subtree.        */
+    NodeRef node;                       /**< Root of subtree.                 */
+
+    /**
+     * @brief Order of priority queue, best candidate is on top.
+     */
+    bool operator<(const CompletionCandidate & i_other) const
+    {
+        if (score != i_other.score)
+        {
+            return score < i_other.score;
+        }
+        // prefix of subtree is not greater than its keys
+        if (key != i_other.key)
+        {
+            return i_other.key < key;
+        }
+        return !is_key && i_other.is_key;
+    }
+};
+
+/**
+ * @brief Finds keys with highest scores in subtree by best-first search.
+ *
+ * Bound of subtree is its maximal score, so keys are found in order of
+ * descending score (ties by key). Access provides for node: has_keys(),
+ * max_score(), is_key(), score() and for_each_child(func) which calls
+ * func(character, child) for all children.
+ *
+ * @param[in] i_access Access to trie nodes.
+ * @param[in] i_node Node of prefix.
+ * @param[in] i_prefix Prefix of keys.
+ * @param[in] i_k Maximal number of keys.
+ * @return Keys ordered by descending score (ties by key).
+ */
+template<class Access, class NodeRef>
+std::vector<std::string> complete_keys(const Access & i_access, NodeRef i_node, std::string_view i_prefix, std::size_t i_k)
+{
+    typedef CompletionCandidate<NodeRef> Candidate;
+
+    std::vector<std::string> res;
+    if (i_k == 0 || !i_access.has_keys(i_node))
+    {
+        return res;
+    }
+
+    std::priority_queue<Candidate> queue;
+    queue.push(Candidate{ i_access.max_score(i_node), false, std::string(i_prefix), i_node });
+
+    while (!queue.empty() && res.size() < i_k)
+    {
+        Candidate top = queue.top();
+        queue.pop();
+
+        // no other candidate can have higher score
+        if (top.is_key)
+        {
+            res.push_back(top.key);
+            continue;
+        }
+
+        if (i_access.is_key(top.node))
+        {
+            queue.push(Candidate{ i_access.score(top.node), true, top.key, top.node });
+        }
+
+        // subtrees which don't contain keys are skipped
+        i_access.for_each_child(top.node, [&](char i_chr, NodeRef i_next)
+        {
+            if (i_access.has_keys(i_next))
+            {
+                queue.push(Candidate{ i_access.max_score(i_next), false, top.key + i_chr, i_next });
+            }
+        });
+    }
+
+    return res;
+}
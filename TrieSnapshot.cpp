@@ -0,0 +1,661 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "TrieCompletion.hpp"
+#include "TrieSnapshot.hpp"
+
+namespace
+{
+    /**
+     * @brief Signatures of snapshots.
+     */
+    const std::uint32_t TRIE_MAGIC = 0x33504E53;   // "SNP3"
+    const std::uint32_t DNS_MAGIC = 0x31534E44;    // "DNS1"
+
+    /**
+     * @brief Number of characters of IP address, digits and dot.
+     */
+    const std::size_t ALPHABET = 11;
+
+    /**
+     * @brief Footer of snapshot, written after all records.
+     */
+    struct Footer
+    {
+        std::uint32_t magic;         /**< Signature.                            */
+        std::uint32_t num_nodes;     /**< Number of records.                    */
+        std::uint32_t extra;         /**< Alphabet size or size of URL pool.    */
+        std::uint32_t reserved;      /**< Padding.                              */
+    };
+
+    /**
+     * @brief Reads footer and checks size of records.
+     * @return True if buffer holds footer with given signature and all records.
+     */
+    bool read_footer(const void * i_data, std::size_t i_bytes, std::uint32_t i_magic, std::size_t i_record, Footer & o_footer)
+    {
+        if (i_data == nullptr || i_bytes < sizeof(Footer))
+        {
+            return false;
+        }
+
+        std::memcpy(&o_footer, static_cast<const char *>(i_data) + i_bytes - sizeof(Footer), sizeof(Footer));
+        return o_footer.magic == i_magic && o_footer.num_nodes > 0 &&
+               static_cast<std::uint64_t>(o_footer.num_nodes) * i_record <= i_bytes - sizeof(Footer);
+    }
+
+    /**
+     * @brief Checks that children of node are in bounds and follow the node.
+     *
+     * Queries check every record they visit, so corrupted snapshot can't lead
+     * them out of buffer or into cycle.
+     *
+     * @return True if children can be visited.
+     */
+    template<class Record>
+    bool valid_children(const Record * i_nodes, std::size_t i_node, std::size_t i_num_nodes)
+    {
+        const Record & record = i_nodes[i_node];
+        return record.num_children == 0 ||
+               (record.first_child > i_node && record.first_child <= i_num_nodes &&
+                record.num_children <= i_num_nodes - record.first_child);
+    }
+
+    /**
+     * @brief Access to snapshot records for autocomplete.
+     */
+    struct RecordAccess
+    {
+        const MappedTrie::Record * nodes;   /**< Records of snapshot.  */
+        std::size_t num_nodes;              /**< Number of records.    */
+
+        bool has_keys(std::size_t i_node) const
+        {
+            return nodes[i_node].has_keys != 0;
+        }
+
+        long long max_score(std::size_t i_node) const
+        {
+            return nodes[i_node].max_score;
+        }
+
+        bool is_key(std::size_t i_node) const
+        {
+            return nodes[i_node].value > 0;
+        }
+
+        long long score(std::size_t i_node) const
+        {
+            return nodes[i_node].score;
+        }
+
+        template<class Func>
+        void for_each_child(std::size_t i_node, Func i_func) const
+        {
+            if (!valid_children(nodes, i_node, num_nodes))
+            {
+                return;
+            }
+
+            const std::size_t begin = nodes[i_node].first_child;
+            for (std::size_t next = begin; next < begin + nodes[i_node].num_children; ++next)
+            {
+                i_func(static_cast<char>('a' + nodes[next].label), next);
+            }
+        }
+    };
+
+    /**
+     * @brief Writes snapshot to file.
+     */
+    template<class Snapshot, class Source>
+    bool save_util(const Source & i_source, const std::string & i_path)
+    {
+        std::ofstream out(i_path.c_str(), std::ios::binary);
+        return Snapshot::write(i_source, out) && static_cast<bool>(out.flush());
+    }
+
+    /**
+     * @brief Finds child with given label among contiguous sorted records.
+     * @return Index of child or i_end if there is no such child.
+     */
+    template<class Record>
+    std::size_t find_child(const Record * i_nodes, std::size_t i_begin, std::size_t i_end, std::uint8_t i_label)
+    {
+        std::size_t lo = i_begin;
+        std::size_t hi = i_end;
+        while (lo < hi)
+        {
+            const std::size_t mid = lo + (hi - lo) / 2;
+            if (i_nodes[mid].label < i_label)
+            {
+                lo = mid + 1;
+            }
+            else
+            {
+                hi = mid;
+            }
+        }
+        return (lo < i_end && i_nodes[lo].label == i_label) ? lo : i_end;
+    }
+
+    /**
+     * @brief Checks that records form tree in BFS order, as produced by write().
+     *
+     * Children of each node must follow children of previous nodes, so every
+     * child index is in bounds and greater than index of its parent. Labels of
+     * siblings must be increasing and less than alphabet size.
+     *
+     * @return True if records are valid.
+     */
+    template<class Record>
+    bool valid_tree(const Record * i_nodes, std::size_t i_num_nodes, std::size_t i_alphabet)
+    {
+        std::size_t next = 1;
+        for (std::size_t node = 0; node < i_num_nodes; ++node)
+        {
+            const Record & record = i_nodes[node];
+            if (record.first_child != next || record.num_children > i_num_nodes - next)
+            {
+                return false;
+            }
+
+            for (std::size_t pos = next; pos < next + record.num_children; ++pos)
+            {
+                if (i_nodes[pos].label >= i_alphabet || (pos > next && i_nodes[pos].label <= i_nodes[pos - 1].label))
+                {
+                    return false;
+                }
+            }
+            next += record.num_children;
+        }
+
+        return next == i_num_nodes;
+    }
+}
+
+/**
+* @brief Destructor, unmaps file.
+*/
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+/**
+* @brief Move constructor.
+*/
+MappedFile::MappedFile(MappedFile && io_other)
+    : m_data(io_other.m_data)
+    , m_size(io_other.m_size)
+{
+    io_other.m_data = nullptr;
+    io_other.m_size = 0;
+}
+
+/**
+* @brief Move assignment.
+*/
+MappedFile & MappedFile::operator=(MappedFile && io_other)
+{
+    if (this != &io_other)
+    {
+        close();
+        m_data = io_other.m_data;
+        m_size = io_other.m_size;
+        io_other.m_data = nullptr;
+        io_other.m_size = 0;
+    }
+    return *this;
+}
+
+/**
+* @brief Unmaps file.
+*/
+void MappedFile::close()
+{
+    if (m_data != nullptr)
+    {
+        munmap(m_data, m_size);
+        m_data = nullptr;
+        m_size = 0;
+    }
+}
+
+/**
+* @brief Maps file into memory.
+* @param[in] i_path Path to file.
+* @return True on success.
+*/
+bool MappedFile::open(const std::string & i_path)
+{
+    close();
+
+    const int fd = ::open(i_path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0)
+    {
+        ::close(fd);
+        return false;
+    }
+
+    // mapping stays valid after descriptor is closed
+    void * data = mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (data == MAP_FAILED)
+    {
+        return false;
+    }
+
+    m_data = data;
+    m_size = static_cast<std::size_t>(st.st_size);
+    return true;
+}
+
+/**
+* @brief Writes snapshot of trie.
+* @param[in] i_trie Trie.
+* @param[out] o_out Output stream.
+* @return True on success.
+*/
+bool MappedTrie::write(const Trie & i_trie, std::ostream & o_out)
+{
+    const std::size_t alphabet = i_trie.alphabet_size();
+
+    // nodes with labels in BFS order, index of node is its position in queue
+    std::deque<std::pair<const Trie::TrieNode *, std::uint8_t>> queue(1, std::make_pair(i_trie.root(), std::uint8_t(0)));
+    std::uint32_t next = 1;
+
+    while (!queue.empty())
+    {
+        const Trie::TrieNode * node = queue.front().first;
+        Record record = { node->score, node->max_score, node->value, next, 0, queue.front().second, node->has_keys ? std::uint8_t(1) : std::uint8_t(0) };
+        queue.pop_front();
+
+        for (std::size_t pos = 0; pos < alphabet; ++pos)
+        {
+            if (node->child[pos] != nullptr)
+            {
+                queue.push_back(std::make_pair(node->child[pos], static_cast<std::uint8_t>(pos)));
+                record.num_children++;
+            }
+        }
+        next += record.num_children;
+
+        o_out.write(reinterpret_cast<const char *>(&record), sizeof(Record));
+    }
+
+    const Footer footer = { TRIE_MAGIC, next, static_cast<std::uint32_t>(alphabet), 0 };
+    o_out.write(reinterpret_cast<const char *>(&footer), sizeof(Footer));
+
+    return static_cast<bool>(o_out);
+}
+
+/**
+* @brief Writes snapshot of trie to file.
+* @param[in] i_trie Trie.
+* @param[in] i_path Path to file.
+* @return True on success.
+*/
+bool MappedTrie::save(const Trie & i_trie, const std::string & i_path)
+{
+    return save_util<MappedTrie>(i_trie, i_path);
+}
+
+/**
+* @brief Creates snapshot which uses buffer in place.
+* @param[in] i_data Buffer created by write(), aligned to 8 bytes.
+* @param[in] i_bytes Size of buffer.
+* @return Snapshot which refers to buffer, empty snapshot if buffer is invalid.
+* @note Only footer is checked here, records are checked when visited.
+*/
+MappedTrie MappedTrie::view(const void * i_data, std::size_t i_bytes)
+{
+    MappedTrie res;
+
+    Footer footer;
+    if (read_footer(i_data, i_bytes, TRIE_MAGIC, sizeof(Record), footer))
+    {
+        res.m_nodes = static_cast<const Record *>(i_data);
+        res.m_num_nodes = footer.num_nodes;
+        res.m_alphabet = footer.extra;
+    }
+
+    return res;
+}
+
+/**
+* @brief Maps snapshot file into memory.
+* @param[in] i_path Path to file.
+* @return True on success.
+*/
+bool MappedTrie::open(const std::string & i_path)
+{
+    MappedFile file;
+    if (!file.open(i_path))
+    {
+        return false;
+    }
+
+    MappedTrie res = view(file.data(), file.size());
+    if (res.m_num_nodes == 0)
+    {
+        return false;
+    }
+
+    res.m_file = std::move(file);
+    *this = std::move(res);
+    return true;
+}
+
+/**
+* @brief Checks structure of all records in one linear pass.
+* @return True if records form tree as produced by write().
+*/
+bool MappedTrie::validate() const
+{
+    return m_num_nodes == 0 || valid_tree(m_nodes, m_num_nodes, m_alphabet);
+}
+
+/**
+* @brief Follows edge from node.
+* @return Index of child or num_nodes if there is no such child.
+*/
+std::size_t MappedTrie::child(std::size_t i_node, char i_chr) const
+{
+    // characters outside of alphabet have no edges
+    const std::size_t idx = static_cast<unsigned char>(i_chr - 'a');
+    if (idx >= m_alphabet || !valid_children(m_nodes, i_node, m_num_nodes))
+    {
+        return m_num_nodes;
+    }
+
+    const std::size_t begin = m_nodes[i_node].first_child;
+    const std::size_t end = begin + m_nodes[i_node].num_children;
+    const std::size_t res = find_child(m_nodes, begin, end, static_cast<std::uint8_t>(idx));
+    return (res == end) ? m_num_nodes : res;
+}
+
+/**
+* @brief Searches key in snapshot.
+* @param[in] i_key Key to be searched.
+* @return True if key is present in snapshot or False otherwise.
+*/
+bool MappedTrie::search(std::string_view i_key) const
+{
+    if (m_num_nodes == 0)
+    {
+        return false;
+    }
+
+    std::size_t node = 0;
+    for (std::size_t level = 0; level < i_key.size(); ++level)
+    {
+        node = child(node, i_key[level]);
+        if (node == m_num_nodes)
+        {
+            return false;
+        }
+    }
+
+    return m_nodes[node].value > 0;
+}
+
+/**
+* @brief Finds length of longest prefix of input string which is in snapshot keys.
+* @param[in] i_key Key to be searched.
+* @return Length of longest prefix or 0 if there is no such key.
+*/
+std::size_t MappedTrie::longest_prefix_length(std::string_view i_key) const
+{
+    if (m_num_nodes == 0)
+    {
+        return 0;
+    }
+
+    std::size_t prev_pos = 0;
+    std::size_t node = 0;
+    for (std::size_t level = 0; level < i_key.size(); ++level)
+    {
+        node = child(node, i_key[level]);
+        if (node == m_num_nodes)
+        {
+            break;
+        }
+
+        // store previous matching prefix
+        if (m_nodes[node].value > 0)
+        {
+            prev_pos = level + 1;
+        }
+    }
+
+    return prev_pos;
+}
+
+/**
+* @brief Finds keys with highest scores which start with given prefix.
+* @param[in] i_prefix Prefix of keys.
+* @param[in] i_k Maximal number of keys.
+* @return Keys ordered by descending score (ties by key), the same as Trie::complete().
+*/
+std::vector<std::string> MappedTrie::complete(std::string_view i_prefix, std::size_t i_k) const
+{
+    if (m_num_nodes == 0)
+    {
+        return std::vector<std::string>();
+    }
+
+    // find node of prefix
+    std::size_t node = 0;
+    for (std::size_t level = 0; level < i_prefix.size(); ++level)
+    {
+        node = child(node, i_prefix[level]);
+        if (node == m_num_nodes)
+        {
+            return std::vector<std::string>();
+        }
+    }
+
+    return complete_keys(RecordAccess{ m_nodes, m_num_nodes }, node, i_prefix, i_k);
+}
+
+/**
+* @brief Writes snapshot of cache.
+* @param[in] i_cache Cache.
+* @param[out] o_out Output stream.
+* @return True on success.
+*/
+bool MappedReverseDNSCache::write(const ReverseDNSCache & i_cache, std::ostream & o_out)
+{
+    // URLs are collected while records are written and follow them
+    std::string pool;
+
+    std::deque<std::pair<const ReverseDNSCache::Node *, std::uint8_t>> queue(1, std::make_pair(i_cache.root(), std::uint8_t(0)));
+    std::uint32_t next = 1;
+
+    while (!queue.empty())
+    {
+        const ReverseDNSCache::Node * node = queue.front().first;
+        Record record = { next, 0, 0, 0, queue.front().second, static_cast<std::uint8_t>(node->is_leaf ? 1 : 0), 0 };
+        queue.pop_front();
+
+        if (node->is_leaf)
+        {
+            record.url_offset = static_cast<std::uint32_t>(pool.size());
+            record.url_size = static_cast<std::uint32_t>(node->url.size());
+            pool += node->url;
+        }
+
+        for (std::size_t pos = 0; pos < node->child.size(); ++pos)
+        {
+            if (node->child[pos] != nullptr)
+            {
+                queue.push_back(std::make_pair(node->child[pos], static_cast<std::uint8_t>(pos)));
+                record.num_children++;
+            }
+        }
+        next += record.num_children;
+
+        o_out.write(reinterpret_cast<const char *>(&record), sizeof(Record));
+    }
+
+    // pool is padded to keep footer aligned
+    pool.resize((pool.size() + 3) / 4 * 4, '\0');
+    o_out.write(pool.data(), pool.size());
+
+    const Footer footer = { DNS_MAGIC, next, static_cast<std::uint32_t>(pool.size()), 0 };
+    o_out.write(reinterpret_cast<const char *>(&footer), sizeof(Footer));
+
+    return static_cast<bool>(o_out);
+}
+
+/**
+* @brief Writes snapshot of cache to file.
+* @param[in] i_cache Cache.
+* @param[in] i_path Path to file.
+* @return True on success.
+*/
+bool MappedReverseDNSCache::save(const ReverseDNSCache & i_cache, const std::string & i_path)
+{
+    return save_util<MappedReverseDNSCache>(i_cache, i_path);
+}
+
+/**
+* @brief Creates snapshot which uses buffer in place.
+* @param[in] i_data Buffer created by write(), aligned to 4 bytes.
+* @param[in] i_bytes Size of buffer.
+* @return Snapshot which refers to buffer, empty snapshot if buffer is invalid.
+* @note Only footer is checked here, records are checked when visited.
+*/
+MappedReverseDNSCache MappedReverseDNSCache::view(const void * i_data, std::size_t i_bytes)
+{
+    MappedReverseDNSCache res;
+
+    Footer footer;
+    if (read_footer(i_data, i_bytes, DNS_MAGIC, sizeof(Record), footer) &&
+        static_cast<std::uint64_t>(footer.num_nodes) * sizeof(Record) + footer.extra + sizeof(Footer) <= i_bytes)
+    {
+        res.m_nodes = static_cast<const Record *>(i_data);
+        res.m_pool = static_cast<const char *>(i_data) + footer.num_nodes * sizeof(Record);
+        res.m_pool_size = footer.extra;
+        res.m_num_nodes = footer.num_nodes;
+    }
+
+    return res;
+}
+
+/**
+* @brief Maps snapshot file into memory.
+* @param[in] i_path Path to file.
+* @return True on success.
+*/
+bool MappedReverseDNSCache::open(const std::string & i_path)
+{
+    MappedFile file;
+    if (!file.open(i_path))
+    {
+        return false;
+    }
+
+    MappedReverseDNSCache res = view(file.data(), file.size());
+    if (res.m_num_nodes == 0)
+    {
+        return false;
+    }
+
+    res.m_file = std::move(file);
+    *this = std::move(res);
+    return true;
+}
+
+/**
+* @brief Checks structure of all records and URLs in one linear pass.
+* @return True if records form tree as produced by write().
+*/
+bool MappedReverseDNSCache::validate() const
+{
+    if (m_num_nodes == 0)
+    {
+        return true;
+    }
+    if (!valid_tree(m_nodes, m_num_nodes, ALPHABET))
+    {
+        return false;
+    }
+
+    // URLs of leaves must be inside of pool
+    for (std::size_t node = 0; node < m_num_nodes; ++node)
+    {
+        if (m_nodes[node].is_leaf && static_cast<std::uint64_t>(m_nodes[node].url_offset) + m_nodes[node].url_size > m_pool_size)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+* @brief Reverse DNS search.
+* @param[in] i_ip IP address.
+* @return URL stored in snapshot or nothing if IP is not found.
+*/
+std::optional<std::string_view> MappedReverseDNSCache::find(std::string_view i_ip) const
+{
+    if (m_num_nodes == 0)
+    {
+        return std::nullopt;
+    }
+
+    std::size_t node = 0;
+    for (std::size_t level = 0; level < i_ip.size(); ++level)
+    {
+        // the same indices as in ReverseDNSCache
+        const char chr = i_ip[level];
+        if (chr != '.' && (chr < '0' || chr > '9'))
+        {
+            return std::nullopt;
+        }
+        const std::uint8_t idx = static_cast<std::uint8_t>((chr == '.') ? ALPHABET - 1 : (chr - '0'));
+
+        if (!valid_children(m_nodes, node, m_num_nodes))
+        {
+            return std::nullopt;
+        }
+
+        const std::size_t begin = m_nodes[node].first_child;
+        const std::size_t end = begin + m_nodes[node].num_children;
+        node = find_child(m_nodes, begin, end, idx);
+        if (node == end)
+        {
+            return std::nullopt;
+        }
+    }
+
+    // URL of corrupted record is not trusted
+    if (!m_nodes[node].is_leaf || static_cast<std::uint64_t>(m_nodes[node].url_offset) + m_nodes[node].url_size > m_pool_size)
+    {
+        return std::nullopt;
+    }
+
+    return std::string_view(m_pool + m_nodes[node].url_offset, m_nodes[node].url_size);
+}
@@ -0,0 +1,292 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Trie.hpp"
+#include "TrieUsage.hpp"
+
+/**
+ * @brief Read-only memory mapping of whole file.
+ */
+class MappedFile
+{
+public:
+    /**
+     * @brief Constructs empty mapping.
+     */
+    MappedFile()
+        : m_data(nullptr)
+        , m_size(0)
+    {}
+
+    /**
+     * @brief Destructor, unmaps file.
+     */
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile & operator=(const MappedFile &) = delete;
+    MappedFile(MappedFile && io_other);
+    MappedFile & operator=(MappedFile && io_other);
+
+    /**
+     * @brief Maps file into memory.
+     * @param[in] i_path Path to file.
+     * @return True on success.
+     */
+    bool open(const std::string & i_path);
+
+    /**
+     * @brief Gets mapped data.
+     */
+    const void * data() const
+    {
+        return m_data;
+    }
+
+    /**
+     * @brief Gets size of mapped data.
+     */
+    std::size_t size() const
+    {
+        return m_size;
+    }
+
+private:
+    /**
+     * @brief Unmaps file.
+     */
+    void close();
+
+    void * m_data;           /**< Mapped data.             */
+    std::size_t m_size;      /**< Size of mapped data.     */
+};
+
+/**
+ * @brief Trie snapshot queried in place.
+ *
+ * Nodes are written in BFS order as fixed size records, children of node are
+ * contiguous and referred by index of the first one, so format has no pointers.
+ * Records are followed by footer, so snapshot is written in one sequential pass.
+ * Scores are kept, so snapshot serves autocomplete as well.
+ */
+class MappedTrie
+{
+public:
+    /**
+     * @brief Constructs empty snapshot.
+     */
+    MappedTrie()
+        : m_nodes(nullptr)
+        , m_num_nodes(0)
+        , m_alphabet(0)
+    {}
+
+    MappedTrie(const MappedTrie &) = delete;
+    MappedTrie & operator=(const MappedTrie &) = delete;
+    MappedTrie(MappedTrie &&) = default;
+    MappedTrie & operator=(MappedTrie &&) = default;
+
+    /**
+     * @brief Writes snapshot of trie.
+     * @param[in] i_trie Trie.
+     * @param[out] o_out Output stream.
+     * @return True on success.
+     */
+    static bool write(const Trie & i_trie, std::ostream & o_out);
+
+    /**
+     * @brief Writes snapshot of trie to file.
+     * @param[in] i_trie Trie.
+     * @param[in] i_path Path to file.
+     * @return True on success.
+     */
+    static bool save(const Trie & i_trie, const std::string & i_path);
+
+    /**
+     * @brief Creates snapshot which uses buffer in place.
+     * @param[in] i_data Buffer created by write(), aligned to 8 bytes.
+     * @param[in] i_bytes Size of buffer.
+     * @return Snapshot which refers to buffer, empty snapshot if buffer is invalid.
+     * @note Only footer is checked here, so no page of records is touched.
+     *       Records are bounds-checked when queries visit them, validate()
+     *       checks all of them at once.
+     */
+    static MappedTrie view(const void * i_data, std::size_t i_bytes);
+
+    /**
+     * @brief Maps snapshot file into memory.
+     * @param[in] i_path Path to file.
+     * @return True on success.
+     */
+    bool open(const std::string & i_path);
+
+    /**
+     * @brief Gets number of nodes.
+     */
+    std::size_t num_nodes() const
+    {
+        return m_num_nodes;
+    }
+
+    /**
+     * @brief Checks structure of all records in one linear pass.
+     * @return True if records form tree as produced by write().
+     */
+    bool validate() const;
+
+    /**
+     * @brief Searches key in snapshot.
+     * @param[in] i_key Key to be searched.
+     * @return True if key is present in snapshot or False otherwise.
+     */
+    bool search(std::string_view i_key) const;
+
+    /**
+     * @brief Finds length of longest prefix of input string which is in snapshot keys.
+     * @param[in] i_key Key to be searched.
+     * @return Length of longest prefix or 0 if there is no such key.
+     */
+    std::size_t longest_prefix_length(std::string_view i_key) const;
+
+    /**
+     * @brief Finds keys with highest scores which start with given prefix.
+     * @param[in] i_prefix Prefix of keys.
+     * @param[in] i_k Maximal number of keys.
+     * @return Keys ordered by descending score (ties by key), the same as Trie::complete().
+     */
+    std::vector<std::string> complete(std::string_view i_prefix, std::size_t i_k) const;
+
+    /**
+     * @brief Node record of snapshot.
+     */
+    struct Record
+    {
+        std::int64_t score;          /**< Score of key which ends in node.  */
+        std::int64_t max_score;      /**< Maximal score of keys in subtree. */
+        std::int32_t value;          /**< Value stored in node.             */
+        std::uint32_t first_child;   /**< Index of first child.             */
+        std::uint16_t num_children;  /**< Number of children.               */
+        std::uint8_t label;          /**< Index of edge from parent.        */
+        std::uint8_t has_keys;       /**< Whether subtree contains any key. */
+    };
+
+private:
+    /**
+     * @brief Follows edge from node.
+     * @return Index of child or num_nodes if there is no such child.
+     */
+    std::size_t child(std::size_t i_node, char i_chr) const;
+
+    MappedFile m_file;           /**< Mapping of snapshot file.       */
+    const Record * m_nodes;      /**< Records of nodes.               */
+    std::size_t m_num_nodes;     /**< Number of nodes.                */
+    std::size_t m_alphabet;      /**< Alphabet size.                  */
+};
+
+/**
+ * @brief ReverseDNSCache snapshot queried in place.
+ *
+ * Nodes are written in BFS order as fixed size records followed by pool of
+ * URLs referred by offsets and footer.
+ */
+class MappedReverseDNSCache
+{
+public:
+    /**
+     * @brief Constructs empty snapshot.
+     */
+    MappedReverseDNSCache()
+        : m_nodes(nullptr)
+        , m_pool(nullptr)
+        , m_pool_size(0)
+        , m_num_nodes(0)
+    {}
+
+    MappedReverseDNSCache(const MappedReverseDNSCache &) = delete;
+    MappedReverseDNSCache & operator=(const MappedReverseDNSCache &) = delete;
+    MappedReverseDNSCache(MappedReverseDNSCache &&) = default;
+    MappedReverseDNSCache & operator=(MappedReverseDNSCache &&) = default;
+
+    /**
+     * @brief Writes snapshot of cache.
+     * @param[in] i_cache Cache.
+     * @param[out] o_out Output stream.
+     * @return True on success.
+     */
+    static bool write(const ReverseDNSCache & i_cache, std::ostream & o_out);
+
+    /**
+     * @brief Writes snapshot of cache to file.
+     * @param[in] i_cache Cache.
+     * @param[in] i_path Path to file.
+     * @return True on success.
+     */
+    static bool save(const ReverseDNSCache & i_cache, const std::string & i_path);
+
+    /**
+     * @brief Creates snapshot which uses buffer in place.
+     * @param[in] i_data Buffer created by write(), aligned to 4 bytes.
+     * @param[in] i_bytes Size of buffer.
+     * @return Snapshot which refers to buffer, empty snapshot if buffer is invalid.
+     * @note Only footer is checked here, so no page of records is touched.
+     *       Records are bounds-checked when queries visit them, validate()
+     *       checks all of them at once.
+     */
+    static MappedReverseDNSCache view(const void * i_data, std::size_t i_bytes);
+
+    /**
+     * @brief Maps snapshot file into memory.
+     * @param[in] i_path Path to file.
+     * @return True on success.
+     */
+    bool open(const std::string & i_path);
+
+    /**
+     * @brief Gets number of nodes.
+     */
+    std::size_t num_nodes() const
+    {
+        return m_num_nodes;
+    }
+
+    /**
+     * @brief Checks structure of all records and URLs in one linear pass.
+     * @return True if records form tree as produced by write().
+     */
+    bool validate() const;
+
+    /**
+     * @brief Reverse DNS search.
+     * @param[in] i_ip IP address.
+     * @return URL stored in snapshot or nothing if IP is not found.
+     */
+    std::optional<std::string_view> find(std::string_view i_ip) const;
+
+    /**
+     * @brief Node record of snapshot.
+     */
+    struct Record
+    {
+        std::uint32_t first_child;   /**< Index of first child.           */
+        std::uint32_t url_offset;    /**< Offset of URL in pool.          */
+        std::uint32_t url_size;      /**< Length of URL.                  */
+        std::uint8_t num_children;   /**< Number of children.             */
+        std::uint8_t label;          /**< Index of edge from parent.      */
+        std::uint8_t is_leaf;        /**< Indicator of a leaf node.       */
+        std::uint8_t reserved;       /**< Padding.                        */
+    };
+
+private:
+    MappedFile m_file;           /**< Mapping of snapshot file.       */
+    const Record * m_nodes;      /**< Records of nodes.               */
+    const char * m_pool;         /**< Pool of URLs.                   */
+    std::size_t m_pool_size;     /**< Size of pool of URLs.           */
+    std::size_t m_num_nodes;     /**< Number of nodes.                */
+};
@@ -1,4 +1,7 @@
 #include <string>
+#include <string_view>
+#include <vector>
+#include <algorithm>
 
 #include "TrieUsage.hpp"
 
@@ -13,6 +16,23 @@ namespace
     {
         return (i_chr == '.') ? 10 : (i_chr - '0');
     }
+
+    /**
+     * @brief Number of lookups advanced together by batch search.
+     */
+    const std::size_t BATCH_GROUP = 8;
+
+    /**
+     * @brief Hints processor to fetch memory for reading.
+     */
+    void prefetch(const void * i_addr)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_prefetch(i_addr);
+#else
+        (void)i_addr;
+#endif
+    }
 }
 
 /**
@@ -51,7 +71,23 @@ void ReverseDNSCache::insert(const std::string & i_ip, const std::string & i_url
 * @param[in] i_ip IP address.
 * @return URL which corresponds to given IP.
 */
-std::string ReverseDNSCache::search(const std::string & i_ip) const
+std::string ReverseDNSCache::search(std::string_view i_ip) const
+{
+    const std::string * url = find(i_ip);
+    if (url != nullptr)
+    {
+        return *url;
+    }
+
+    return std::string("IP not found");
+}
+
+/**
+* @brief Reverse DNS search without copying URL.
+* @param[in] i_ip IP address.
+* @return Pointer to URL which corresponds to given IP or nullptr if IP is not found.
+*/
+const std::string * ReverseDNSCache::find(std::string_view i_ip) const
 {
     // copy root
     Node * node = m_root;
@@ -64,7 +100,7 @@ std::string ReverseDNSCache::search(const std::string & i_ip) const
         // IP not found
         if (node->child[index] == nullptr)
         {
-            return std::string("IP not found");
+            return nullptr;
         }
 
         // move to next node
@@ -74,8 +110,70 @@ std::string ReverseDNSCache::search(const std::string & i_ip) const
     // found IP
     if (node != nullptr && node->is_leaf)
     {
-        return node->url;
+        return &node->url;
     }
 
-    return std::string("IP not found");
+    return nullptr;
+}
+
+/**
+* @brief Reverse DNS search of many addresses with interleaved memory prefetch.
+* @param[in] i_ips IP addresses.
+* @param[out] o_urls Pointers to URLs in the same order, nullptr if IP is not found.
+*/
+void ReverseDNSCache::search_batch(const std::vector<std::string_view> & i_ips, std::vector<const std::string *> & o_urls) const
+{
+    o_urls.assign(i_ips.size(), nullptr);
+
+    for (std::size_t begin = 0; begin < i_ips.size(); begin += BATCH_GROUP)
+    {
+        const std::size_t count = std::min(BATCH_GROUP, i_ips.size() - begin);
+
+        // current node of each lookup in group
+        const Node * nodes[BATCH_GROUP];
+        for (std::size_t pos = 0; pos < count; ++pos)
+        {
+            nodes[pos] = m_root;
+        }
+
+        // advance all lookups by one character in two passes, node and its child array
+        // are separate allocations, so each is fetched while other lookups are processed
+        bool active = true;
+        for (std::size_t level = 0; active; ++level)
+        {
+            for (std::size_t pos = 0; pos < count; ++pos)
+            {
+                const std::string_view ip = i_ips[begin + pos];
+                if (nodes[pos] != nullptr && level < ip.size())
+                {
+                    prefetch(&nodes[pos]->child[idx(ip[level])]);
+                }
+            }
+
+            active = false;
+            for (std::size_t pos = 0; pos < count; ++pos)
+            {
+                const std::string_view ip = i_ips[begin + pos];
+                if (nodes[pos] == nullptr || level >= ip.size())
+                {
+                    continue;
+                }
+
+                nodes[pos] = nodes[pos]->child[idx(ip[level])];
+                if (nodes[pos] != nullptr)
+                {
+                    prefetch(nodes[pos]);
+                    active = true;
+                }
+            }
+        }
+
+        for (std::size_t pos = 0; pos < count; ++pos)
+        {
+            if (nodes[pos] != nullptr && nodes[pos]->is_leaf)
+            {
+                o_urls[begin + pos] = &nodes[pos]->url;
+            }
+        }
+    }
 }
@@ -2,6 +2,7 @@
 
 #include <vector>
 #include <string>
+#include <string_view>
 
 /**
  * @brief Class implements reverse DNS look up.
@@ -47,7 +48,32 @@ public:
      * @param[in] i_ip IP address.
      * @return URL which corresponds to given IP.
      */
-    std::string search(const std::string & i_ip) const;
+    std::string search(std::string_view i_ip) const;
+
+    /**
+     * @brief Reverse DNS search without copying URL.
+     * @param[in] i_ip IP address.
+     * @return Pointer to URL which corresponds to given IP or nullptr if IP is not found.
+     */
+    const std::string * find(std::string_view i_ip) const;
+
+    /**
+     * @brief Reverse DNS search of many addresses with interleaved memory prefetch.
+     *
+     * Both node and its child array are prefetched, one pass over group for each.
+     *
+     * @param[in] i_ips IP addresses.
+     * @param[out] o_urls Pointers to URLs in the same order, nullptr if IP is not found.
+     */
+    void search_batch(const std::vector<std::string_view> & i_ips, std::vector<const std::string *> & o_urls) const;
+
+    /**
+     * @brief Gets root of trie.
+     */
+    const Node * root() const
+    {
+        return m_root;
+    }
 
 private:
     Node * m_root; /**< root of trie. */
@@ -2,35 +2,10 @@
 #include <limits>
 #include <algorithm>
 
+#include "IndexedHeap.hpp"
 #include "UnionFind.hpp"
 #include "WeightedGraph.hpp"
 
-namespace
-{
-    /**
-     * @brief Find minimal key.
-     * @param[in] i_keys Key values.
-     * @oaram[in] i_mst_set Vertices already in mst.
-     * @param[in] i_size Number of vertices in graph.
-     * @return Index of minimal key.
-     */
-    int min_key(const std::vector<int> & i_keys, const std::vector<bool> & i_mst_set, const std::size_t i_size)
-    {
-        int min_value = std::numeric_limits<int>::max(), min_idx = 0;
-
-        for (int idx = 0; idx < (int)i_size; ++idx)
-        {
-            if (!i_mst_set[idx] && i_keys[idx] < min_value)
-            {
-                min_value = i_keys[idx];
-                min_idx = idx;
-            }
-        }
-
-        return min_idx;
-    }
-}
-
 /**
 * @brief Add edge to graph.
 * @param[in] i_v1 First vertex.
@@ -57,17 +32,20 @@ std::vector<std::pair<int, int>> WeightedGraph::prim_mst() const
     std::vector<int> keys(n, std::numeric_limits<int>::max());
     // vertices already in MST
     std::vector<bool> mst_set(n, false);
+    // vertices reached from MST ordered by key
+    IndexedHeap<int> heap(n);
 
-    // include first vertex in mst
-    keys[0] = 0;
-    mst_set[0] = true;
+    // start from first vertex
+    if (n > 0)
+    {
+        keys[0] = 0;
+        heap.push(0, 0);
+    }
 
-    // add n - 1 vertices
-    for (std::size_t vcnt = 0; vcnt < n - 1; ++vcnt)
+    while (!heap.empty())
     {
-        // find vertex with minimum key
-        int vertex = min_key(keys, mst_set, n);
-        // add vertex to mst
+        // add vertex with minimum key to mst
+        const int vertex = static_cast<int>(heap.pop());
         mst_set[vertex] = true;
 
         for (std::size_t ucnt = 0; ucnt < n; ++ucnt)
@@ -78,6 +56,11 @@ std::vector<std::pair<int, int>> WeightedGraph::prim_mst() const
             {
                 parents[ucnt] = vertex;
                 keys[ucnt] = m_matrix[vertex][ucnt];
+
+                if (!heap.decrease_key(ucnt, keys[ucnt]))
+                {
+                    heap.push(ucnt, keys[ucnt]);
+                }
             }
         }
     }
@@ -178,16 +161,17 @@ std::vector<std::pair<int, int>> WeightedGraph::dijkstra(int i_start) const
     std::vector<int> dists(n, std::numeric_limits<int>::max());
     // indicates wether vertex in shortest path tree
     std::vector<bool> shortest_path_tree(n, false);
+    // reached vertices ordered by distance
+    IndexedHeap<int> heap(n);
 
     // set distance to source vertex
     dists[i_start] = 0;
+    heap.push(i_start, 0);
 
-    // add other vertices
-    for (std::size_t cnt = 0; cnt < n - 1; ++cnt)
+    while (!heap.empty())
     {
-        // find minimum key
-        int mkey = min_key(dists, shortest_path_tree, n);
-        // add vertex to shortest path tree
+        // add vertex with minimum distance to shortest path tree
+        const int mkey = static_cast<int>(heap.pop());
         shortest_path_tree[mkey] = true;
 
         // update distances
@@ -195,11 +179,15 @@ std::vector<std::pair<int, int>> WeightedGraph::dijkstra(int i_start) const
         {
             if (m_matrix[mkey][vertex]                            &&    // check if edge exists
                 !shortest_path_tree[vertex]                       &&    // vertex not in tree
-                dists[mkey] != std::numeric_limits<int>::max()    &&
                 dists[mkey] + m_matrix[mkey][vertex] < dists[vertex])
             {
                 // update distance
                 dists[vertex] = dists[mkey] + m_matrix[mkey][vertex];
+
+                if (!heap.decrease_key(vertex, dists[vertex]))
+                {
+                    heap.push(vertex, dists[vertex]);
+                }
             }
         }
     }
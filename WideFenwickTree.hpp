@@ -0,0 +1,245 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <vector>
+#include <type_traits>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+/**
+ * @brief B-ary prefix sum tree, cache friendly alternative to Binary Indexed Tree.
+ *
+ * Every node keeps prefix sums of its Branch children in one contiguous block,
+ * so query reads one value per level and update touches one block per level.
+ * With 4 byte values and Branch = 16 each node occupies exactly one cache line.
+ *
+ * @tparam ValueType Arithmetic type of values stored in tree.
+ * @tparam Branch Number of children of each node.
+ */
+template<class ValueType, std::size_t Branch = 64 / sizeof(ValueType)>
+class WideFenwickTree
+{
+public:
+    static_assert(std::is_arithmetic<ValueType>::value, "WideFenwickTree requires arithmetic values");
+    static_assert(Branch >= 2, "WideFenwickTree requires at least two children per node");
+
+    /**
+     * @brief Constructs tree from given array.
+     * @param[in] i_arr Array of values.
+     * @param[in] i_huge_pages Request transparent huge pages for tree data.
+     */
+    WideFenwickTree(const std::vector<ValueType> & i_arr, bool i_huge_pages = false)
+        : m_data(nullptr)
+        , m_capacity(0)
+        , m_size(i_arr.size())
+    {
+        layout();
+        allocate(i_huge_pages);
+        build(i_arr);
+    }
+
+    /**
+     * @brief Constructs zero filled tree.
+     * @param[in] i_size Number of elements.
+     * @param[in] i_huge_pages Request transparent huge pages for tree data.
+     */
+    WideFenwickTree(const std::size_t i_size, bool i_huge_pages = false)
+        : m_data(nullptr)
+        , m_capacity(0)
+        , m_size(i_size)
+    {
+        layout();
+        allocate(i_huge_pages);
+    }
+
+    WideFenwickTree(const WideFenwickTree &) = delete;
+    WideFenwickTree & operator=(const WideFenwickTree &) = delete;
+
+    /**
+     * @brief Destructor.
+     */
+    ~WideFenwickTree()
+    {
+        std::free(m_data);
+    }
+
+    /**
+     * @brief Gets number of elements.
+     */
+    std::size_t size() const
+    {
+        return m_size;
+    }
+
+    /**
+     * @brief Adds value to element at given index.
+     * @param[in] i_idx Index in array.
+     * @param[in] i_delta Value to be added.
+     */
+    void add(std::size_t i_idx, const ValueType i_delta)
+    {
+        // leaf level, prefixes of block include element itself
+        ValueType * level = m_data;
+        std::size_t end = i_idx - i_idx % Branch + Branch;
+        for (std::size_t pos = i_idx; pos < end; ++pos)
+        {
+            level[pos] += i_delta;
+        }
+
+        // upper levels, prefixes exclude current child
+        for (std::size_t lvl = 1; lvl < m_offsets.size(); ++lvl)
+        {
+            i_idx /= Branch;
+            level = m_data + m_offsets[lvl];
+            end = i_idx - i_idx % Branch + Branch;
+            for (std::size_t pos = i_idx + 1; pos < end; ++pos)
+            {
+                level[pos] += i_delta;
+            }
+        }
+    }
+
+    /**
+     * @brief Gets sum of values in range 0..idx.
+     * @param[in] i_idx Right most index.
+     * @return Sum of range.
+     */
+    ValueType prefix_sum(std::size_t i_idx) const
+    {
+        ValueType s = m_data[i_idx];
+        for (std::size_t lvl = 1; lvl < m_offsets.size(); ++lvl)
+        {
+            i_idx /= Branch;
+            s += m_data[m_offsets[lvl] + i_idx];
+        }
+        return s;
+    }
+
+    /**
+     * @brief Gets sum of values in range left..right.
+     * @param[in] i_left Left border.
+     * @param[in] i_right Right border.
+     * @return Sum of range.
+     */
+    ValueType range_sum(std::size_t i_left, std::size_t i_right) const
+    {
+        if (i_left == 0)
+        {
+            return prefix_sum(i_right);
+        }
+        return prefix_sum(i_right) - prefix_sum(i_left - 1);
+    }
+
+private:
+    /**
+     * @brief Calculates offset of each level.
+     */
+    void layout()
+    {
+        std::size_t nodes = (m_size + Branch - 1) / Branch;
+        if (nodes == 0)
+        {
+            nodes = 1;
+        }
+
+        m_capacity = 0;
+        for (;;)
+        {
+            m_offsets.push_back(m_capacity);
+            m_capacity += nodes * Branch;
+            if (nodes == 1)
+            {
+                break;
+            }
+            nodes = (nodes + Branch - 1) / Branch;
+        }
+    }
+
+    /**
+     * @brief Allocates zero filled memory for all levels.
+     * @param[in] i_huge_pages Request transparent huge pages.
+     */
+    void allocate(bool i_huge_pages)
+    {
+        const std::size_t huge_page = 2 * 1024 * 1024;
+        const std::size_t bytes = m_capacity * sizeof(ValueType);
+
+        // nodes start at cache line boundary, huge pages need 2MB alignment
+        std::size_t align = (i_huge_pages && bytes >= huge_page) ? huge_page : 64;
+        // round size so advice covers whole huge pages
+        const std::size_t rounded = (bytes + align - 1) / align * align;
+
+        void * ptr = nullptr;
+        if (posix_memalign(&ptr, align, rounded) != 0)
+        {
+            throw std::bad_alloc();
+        }
+
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+        if (align == huge_page)
+        {
+            madvise(ptr, rounded, MADV_HUGEPAGE);
+        }
+#endif
+
+        m_data = static_cast<ValueType *>(ptr);
+        for (std::size_t pos = 0; pos < m_capacity; ++pos)
+        {
+            m_data[pos] = ValueType();
+        }
+    }
+
+    /**
+     * @brief Fills all levels from given array.
+     * @param[in] i_arr Array of values.
+     */
+    void build(const std::vector<ValueType> & i_arr)
+    {
+        // totals of nodes at previous level
+        std::vector<ValueType> totals;
+
+        // leaf level, inclusive prefixes inside each block
+        for (std::size_t pos = 0; pos < m_size; ++pos)
+        {
+            const ValueType prev = (pos % Branch == 0) ? ValueType() : m_data[pos - 1];
+            m_data[pos] = prev + i_arr[pos];
+            if (pos % Branch == Branch - 1 || pos + 1 == m_size)
+            {
+                totals.push_back(m_data[pos]);
+            }
+        }
+
+        // upper levels, exclusive prefixes of children totals
+        for (std::size_t lvl = 1; lvl < m_offsets.size(); ++lvl)
+        {
+            ValueType * level = m_data + m_offsets[lvl];
+            std::vector<ValueType> next;
+
+            ValueType acc = ValueType();
+            for (std::size_t pos = 0; pos < totals.size(); ++pos)
+            {
+                if (pos % Branch == 0)
+                {
+                    acc = ValueType();
+                }
+                level[pos] = acc;
+                acc += totals[pos];
+                if (pos % Branch == Branch - 1 || pos + 1 == totals.size())
+                {
+                    next.push_back(acc);
+                }
+            }
+
+            totals.swap(next);
+        }
+    }
+
+    ValueType * m_data;                  /**< Levels of tree, leaf level first. */
+    std::vector<std::size_t> m_offsets;  /**< Offset of each level in data.     */
+    std::size_t m_capacity;              /**< Number of allocated values.       */
+    std::size_t m_size;                  /**< Number of elements.               */
+};